@@ -6,6 +6,7 @@
 #include <sstream>
 #include <iomanip>
 #include <limits>
+#include <numeric>
 #include <cmath>
 
 #ifdef _OPENMP
@@ -34,6 +35,7 @@
 #include <AMReX_FabSet.H>
 #include <AMReX_StateData.H>
 #include <AMReX_PlotFileUtil.H>
+#include <AMReX_AsyncOut.H>
 #include <AMReX_Print.H>
 
 #ifdef BL_LAZY
@@ -97,6 +99,20 @@ namespace
     const std::string CheckPointVersion("CheckPointVersion_1.0");
 
     bool initialized = false;
+
+    // The sum of the cost of each cell over each box
+    Vector<Real> sumLoadBalanceWork (const MultiFab& work)
+    {
+        Vector<Real> cost(work.size(), 0.0);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(work); mfi.isValid(); ++mfi) {
+            cost[mfi.index()] = work[mfi].sum(mfi.validbox(), 0);
+        }
+        ParallelAllReduce::Sum(cost.data(), cost.size(), ParallelContext::CommunicatorSub());
+        return cost;
+    }
 }
 
 //Tan Nov 24, 2017 : I removed this anonymous namespace so I could access the inner variables from other source files 
@@ -517,6 +533,18 @@ Amr::InitAmr ()
 
     loadbalance_max_fac = 1.5;
     pp.query("loadbalance_max_fac", loadbalance_max_fac);
+
+    loadbalance_use_timers = 0;
+    pp.query("loadbalance_use_timers", loadbalance_use_timers);
+
+    loadbalance_chop_fac = 0.0;
+    pp.query("loadbalance_chop_fac", loadbalance_chop_fac);
+
+    loadbalance_strategy = "knapsack";
+    pp.query("loadbalance_strategy", loadbalance_strategy);
+    if (loadbalance_strategy != "knapsack" && loadbalance_strategy != "sfc") {
+        amrex::Abort("Amr: amr.loadbalance_strategy must be knapsack or sfc");
+    }
 }
 
 int
@@ -758,6 +786,8 @@ Amr::deleteDeriveSmallPlotVar (const std::string& name)
 
 Amr::~Amr ()
 {
+    finishAsyncOutput();
+
     levelbld->variableCleanUp();
 
     Amr::Finalize();
@@ -875,6 +905,8 @@ Amr::writePlotFile ()
     BL_PROFILE_REGION_START("Amr::writePlotFile()");
     BL_PROFILE("Amr::writePlotFile()");
 
+    finishAsyncOutput();
+
     VisMF::SetNOutFiles(plot_nfiles);
     VisMF::Header::Version currentVersion(VisMF::GetHeaderVersion());
     VisMF::SetHeaderVersion(plot_headerversion);
@@ -980,6 +1012,12 @@ Amr::writePlotFile ()
 
 	amrex::Print() << "Write plotfile time = " << dPlotFileTime << "  seconds" << "\n\n";
     }
+    if (AsyncOut::UseAsyncOut()) {
+      // ---- renamed in finishAsyncOutput after the data are on disk
+      async_renames.push_back(std::make_pair(pltfileTemp, pltfile));
+      break;
+    }
+
     ParallelDescriptor::Barrier("Amr::writePlotFile::end");
 
     if(ParallelDescriptor::IOProcessor()) {
@@ -1764,6 +1802,8 @@ Amr::checkPoint ()
     BL_PROFILE_REGION_START("Amr::checkPoint()");
     BL_PROFILE("Amr::checkPoint()");
 
+    finishAsyncOutput();
+
     VisMF::SetNOutFiles(checkpoint_nfiles);
     //
     // In checkpoint files always write out FABs in NATIVE format.
@@ -1774,6 +1814,14 @@ Amr::checkPoint ()
 
     VisMF::Header::Version currentVersion(VisMF::GetHeaderVersion());
     VisMF::SetHeaderVersion(checkpoint_headerversion);
+    //
+    // Checkpoints must be exact, so never use the lossy codec.
+    //
+    FabCompression::Codec thePrevCodec = VisMF::GetCompressionCodec();
+    Real thePrevTol = VisMF::GetCompressionTol();
+    if (thePrevCodec == FabCompression::Lossy) {
+        VisMF::SetCompression(FabCompression::ShuffleLZ);
+    }
 
     Real dCheckPointTime0 = amrex::second();
 
@@ -1914,6 +1962,12 @@ Amr::checkPoint ()
 
 	amrex::Print() << "checkPoint() time = " << dCheckPointTime << " secs." << '\n';
     }
+    if (AsyncOut::UseAsyncOut()) {
+      // ---- renamed in finishAsyncOutput after the data are on disk
+      async_renames.push_back(std::make_pair(ckfileTemp, ckfile));
+      break;
+    }
+
     ParallelDescriptor::Barrier("Amr::checkPoint::end");
 
     if(ParallelDescriptor::IOProcessor()) {
@@ -1929,10 +1983,41 @@ Amr::checkPoint ()
   FArrayBox::setFormat(thePrevFormat);
 
   VisMF::SetHeaderVersion(currentVersion);
+  VisMF::SetCompression(thePrevCodec, thePrevTol);
 
   BL_PROFILE_REGION_STOP("Amr::checkPoint()");
 }
 
+void
+Amr::finishAsyncOutput ()
+{
+    if (async_renames.empty()) {
+        return;
+    }
+
+    BL_PROFILE("Amr::finishAsyncOutput()");
+
+    AsyncOut::Finish();
+
+    // The data have changed since they were submitted, so the files
+    // cannot be written again.  Do not give them their final names.
+    long nerrors = AsyncOut::NumErrors();
+    ParallelDescriptor::ReduceLongSum(nerrors);
+    if (nerrors > 0) {
+        amrex::Abort("Amr::finishAsyncOutput: " + std::to_string(nerrors)
+                     + " asynchronous writes failed, see " + async_renames[0].first);
+    }
+
+    if(ParallelDescriptor::IOProcessor()) {
+        for (const auto& r : async_renames) {
+            std::rename(r.first.c_str(), r.second.c_str());
+        }
+    }
+    ParallelDescriptor::Barrier("Renaming temporary files.");
+
+    async_renames.clear();
+}
+
 void
 Amr::RegridOnly (Real time, bool do_io)
 {
@@ -2108,10 +2193,21 @@ Amr::timeStep (int  level,
     perilla::syncAllWorkerThreads();
 #endif
 
+    if (loadbalance_use_timers) {
+        Vector<Real>& costs = amr_level[level]->box_costs;
+        if (costs.size() != boxArray(level).size()) costs.assign(boxArray(level).size(), 0.0);
+        MFIter::startMeasuringBoxCosts(amr_level[level]->boxArray(),
+                                       amr_level[level]->DistributionMap(), costs);
+    }
+
     BL_PROFILE_REGION_START("amr_level.advance");
     Real dt_new = amr_level[level]->advance(time,dt_level[level],iteration,niter);
     BL_PROFILE_REGION_STOP("amr_level.advance");
 
+    if (loadbalance_use_timers) {
+        MFIter::stopMeasuringBoxCosts();
+    }
+
 #if defined(USE_PERILLA_PTHREADS) || defined(USE_PERILLA_OMP)
     perilla::syncAllWorkerThreads();
     if(perilla::isMasterThread())
@@ -2929,7 +3025,17 @@ Amr::regrid (int  lbase,
         //
 
         if (loadbalance_with_workestimates && !initial) {
-            new_dmap[lev] = makeLoadBalanceDistributionMap(lev, time, new_grid_places[lev]);
+            const MultiFab& work = makeLoadBalanceWork(lev, time, new_grid_places[lev]);
+            if (work.empty()) {
+                new_dmap[lev].define(new_grid_places[lev]);
+            } else {
+                Vector<Real> cost = sumLoadBalanceWork(work);
+                if (loadbalance_chop_fac > 0.0) {
+                    chopForLoadBalance(lev, new_grid_places[lev], cost, work);
+                }
+                new_dmap[lev] = makeLoadBalanceDistributionMap(cost, new_grid_places[lev]);
+                resetBoxCosts(lev);
+            }
         }
         else if (new_dmap[lev].empty()) {
 	    new_dmap[lev].define(new_grid_places[lev]);
@@ -3037,39 +3143,189 @@ Amr::makeLoadBalanceDistributionMap (int lev, Real time, const BoxArray& ba) con
         amrex::Print() << "Load balance on level " << lev << " at t = " << time << "\n";
     }
 
-    DistributionMapping newdm;
+    const Vector<Real>& cost = makeLoadBalanceCost(lev, time, ba);
+    if (cost.empty()) {
+        return DistributionMapping(ba);
+    } else {
+        return makeLoadBalanceDistributionMap(cost, ba);
+    }
+}
+
+DistributionMapping
+Amr::makeLoadBalanceDistributionMap (const Vector<Real>& cost, const BoxArray& ba) const
+{
+    if (loadbalance_strategy == "sfc") {
+        return DistributionMapping::makeSFC(cost, ba);
+    } else {
+        Real navg = static_cast<Real>(ba.size()) / static_cast<Real>(ParallelDescriptor::NProcs());
+        int nmax = std::max(std::round(loadbalance_max_fac*navg), std::ceil(navg));
+        return DistributionMapping::makeKnapSack(cost, nmax);
+    }
+}
+
+Vector<Real>
+Amr::makeLoadBalanceCost (int lev, Real time, const BoxArray& ba) const
+{
+    BL_PROFILE("makeLoadBalanceCost()");
 
-    const int work_est_type = amr_level[0]->WorkEstType();
+    if (!amr_level[lev]) return Vector<Real>();
 
-    if (work_est_type < 0) {
-        if (verbose) {
-            amrex::Print() << "\nAMREX WARNING: work estimates type does not exist!\n\n";
+    return sumLoadBalanceWork(makeLoadBalanceWork(lev, time, ba));
+}
+
+MultiFab
+Amr::makeLoadBalanceWork (int lev, Real time, const BoxArray& ba) const
+{
+    BL_PROFILE("makeLoadBalanceWork()");
+
+    if (!amr_level[lev]) return MultiFab();
+
+    AmrLevel& amrlevel = *amr_level[lev];
+    const BoxArray& oldba = amrlevel.boxArray();
+    const DistributionMapping& olddm = amrlevel.DistributionMap();
+
+    DistributionMapping dm;
+    if (ba.size() == oldba.size()) {
+        dm = olddm;
+    } else {
+        dm.define(ba);
+    }
+
+    MultiFab workest(ba, dm, 1, 0, MFInfo(), FArrayBoxFactory());
+
+    bool measured = false;
+    if (loadbalance_use_timers)
+    {
+        // The time of each box is spread evenly over its cells.  Cells not
+        // in the current grids get the average.
+        const Vector<Real>& box_costs = amrlevel.boxCosts();
+        MultiFab tcost(oldba, olddm, 1, 0, MFInfo(), FArrayBoxFactory());
+        Real tsum = 0.0;
+        for (MFIter mfi(tcost); mfi.isValid(); ++mfi) {
+            const int i = mfi.index();
+            const Real c = (i < static_cast<int>(box_costs.size())) ? box_costs[i] : 0.0;
+            tcost[mfi].setVal(c / mfi.validbox().d_numPts());
+            tsum += c;
+        }
+        ParallelDescriptor::ReduceRealSum(tsum);
+
+        if (tsum > 0.0) {
+            measured = true;
+            workest.setVal(tsum / oldba.d_numPts());
+            workest.ParallelCopy(tcost);
+        } else if (verbose) {
+            amrex::Print() << "Amr::makeLoadBalanceCost: no time measured on level " << lev
+                           << ", using the work estimates\n";
         }
-        newdm.define(ba);
     }
-    else if (amr_level[lev])
+
+    if (!measured)
     {
-        DistributionMapping dmtmp;
-        if (ba.size() == boxArray(lev).size()) {
-            dmtmp = DistributionMap(lev);
+        const int work_est_type = amr_level[0]->WorkEstType();
+        if (work_est_type >= 0) {
+            AmrLevel::FillPatch(amrlevel, workest, 0, time, work_est_type, 0, 1, 0);
         } else {
-            dmtmp.define(ba);
+            workest.setVal(1.0);
         }
 
-        MultiFab workest(ba, dmtmp, 1, 0, MFInfo(), FArrayBoxFactory());
-        AmrLevel::FillPatch(*amr_level[lev], workest, 0, time, work_est_type, 0, 1, 0);
+        MultiFab extra(oldba, olddm, 1, 0, MFInfo(), FArrayBoxFactory());
+        extra.setVal(0.0);
+        amrlevel.addLoadBalanceCost(extra, time);
+        workest.ParallelAdd(extra);
+    }
 
-        Real navg = static_cast<Real>(ba.size()) / static_cast<Real>(ParallelDescriptor::NProcs());
-        int nmax = std::max(std::round(loadbalance_max_fac*navg), std::ceil(navg));
+    return workest;
+}
 
-        newdm = DistributionMapping::makeKnapSack(workest, nmax);
+void
+Amr::resetBoxCosts (int lev)
+{
+    if (amr_level[lev]) {
+        Vector<Real>& costs = amr_level[lev]->box_costs;
+        std::fill(costs.begin(), costs.end(), 0.0);
     }
-    else
+}
+
+void
+Amr::chopForLoadBalance (int lev, BoxArray& ba, Vector<Real>& cost, const MultiFab& work) const
+{
+    BL_PROFILE("chopForLoadBalance()");
+
+    const IntVect& bf = blockingFactor(lev);
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int myproc = ParallelDescriptor::MyProc();
+    const DistributionMapping& work_dm = work.DistributionMap();
+
+    // The box of work each box of ba is part of
+    Vector<int> parent(ba.size());
+    std::iota(parent.begin(), parent.end(), 0);
+
+    while (true)
     {
-        newdm.define(ba);
-    }
+        Real total = 0.0;
+        for (Real c : cost) total += c;
+        const Real maxcost = loadbalance_chop_fac * total / nprocs;
 
-    return newdm;
+        BoxList bl(ba.ixType());
+        Vector<int> new_parent;
+        Vector<Real> new_cost;
+        Vector<int> halves;
+        for (int i = 0, N = ba.size(); i < N; ++i)
+        {
+            Box bx = ba[i];
+            int dir = -1;
+            if (cost[i] > maxcost) {
+                // Split the longest direction that has at least two blocks.
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    if (bx.length(idim) >= 2*bf[idim] &&
+                        (dir < 0 || bx.length(idim) > bx.length(dir))) {
+                        dir = idim;
+                    }
+                }
+            }
+            if (dir >= 0) {
+                const int nblocks = bx.length(dir) / bf[dir];
+                const Box& hi = bx.chop(dir, bx.smallEnd(dir) + (nblocks/2)*bf[dir]);
+                halves.push_back(bl.size());
+                bl.push_back(bx);
+                halves.push_back(bl.size());
+                bl.push_back(hi);
+                new_parent.push_back(parent[i]);
+                new_parent.push_back(parent[i]);
+                new_cost.push_back(0.0);
+                new_cost.push_back(0.0);
+            } else {
+                bl.push_back(bx);
+                new_parent.push_back(parent[i]);
+                new_cost.push_back(cost[i]);
+            }
+        }
+
+        if (halves.empty()) break;
+
+        ba = BoxArray(bl);
+
+        // Only the halves are summed again, by the owners of their work.
+        Vector<Real> half_cost(halves.size(), 0.0);
+        for (int k = 0, N = halves.size(); k < N; ++k) {
+            const int p = new_parent[halves[k]];
+            if (work_dm[p] == myproc) {
+                half_cost[k] = work[p].sum(ba[halves[k]], 0);
+            }
+        }
+        ParallelAllReduce::Sum(half_cost.data(), half_cost.size(), ParallelContext::CommunicatorSub());
+        for (int k = 0, N = halves.size(); k < N; ++k) {
+            new_cost[halves[k]] = half_cost[k];
+        }
+
+        cost.swap(new_cost);
+        parent.swap(new_parent);
+
+        if (verbose) {
+            amrex::Print() << "Amr::chopForLoadBalance: level " << lev << " now has "
+                           << ba.size() << " grids\n";
+        }
+    }
 }
 
 void
@@ -3077,6 +3333,7 @@ Amr::LoadBalanceLevel0 (Real time)
 {
     BL_PROFILE("LoadBalanceLevel0()");
     const auto& dm = makeLoadBalanceDistributionMap(0, time, boxArray(0));
+    resetBoxCosts(0);
     InstallNewDistributionMap(0, dm);
     amr_level[0]->post_regrid(0,time);
 }
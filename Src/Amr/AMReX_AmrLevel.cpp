@@ -14,6 +14,7 @@
 #include <AMReX_BLProfiler.H>
 #include <AMReX_Print.H>
 #include <AMReX_VisMF.H>
+#include <AMReX_AsyncOut.H>
 
 #ifdef AMREX_USE_EB
 #include <AMReX_EBFabFactory.H>
@@ -331,7 +332,11 @@ AmrLevel::writePlotFile (const std::string& dir,
     //
     std::string TheFullPath = FullPath;
     TheFullPath += BaseName;
-    VisMF::Write(plotMF,TheFullPath,how,true);
+    if (AsyncOut::UseAsyncOut()) {
+        VisMF::WriteAsyncOut(plotMF,TheFullPath,how,true);
+    } else {
+        VisMF::Write(plotMF,TheFullPath,how,true);
+    }
 
     amrex::prefetchToDevice(plotMF);
 
@@ -963,6 +968,9 @@ FillPatchIterator::Initialize (int  boxGrow,
     const IndexType& boxType = m_leveldata.boxArray().ixType();
     const int level = m_amrlevel.level;
 
+    // The ranges filled from two levels, which are done together
+    Vector<int> two_scomp, two_dcomp, two_ncomp;
+
     for (int i = 0, DComp = 0; i < static_cast<int>(m_range.size()); i++)
     {
         const int SComp = m_range[i].first;
@@ -979,7 +987,9 @@ FillPatchIterator::Initialize (int  boxGrow,
 				       m_amrlevel.parent->blockingFactor(m_amrlevel.level),
 				       boxGrow, boxType, desc.interp(SComp)))
 	    {
-		FillFromTwoLevels(time, idx, SComp, DComp, NComp);
+		two_scomp.push_back(SComp);
+		two_dcomp.push_back(DComp);
+		two_ncomp.push_back(NComp);
 	    } else {
 
 #ifdef AMREX_USE_EB
@@ -1037,6 +1047,10 @@ FillPatchIterator::Initialize (int  boxGrow,
 
         DComp += NComp;
     }
+
+    if (!two_scomp.empty()) {
+        FillFromTwoLevels(time, idx, two_scomp, two_dcomp, two_ncomp);
+    }
     //
     // Call hack to touch up fillPatched data.
     //
@@ -1067,7 +1081,8 @@ FillPatchIterator::FillFromLevel0 (Real time, int idx, int scomp, int dcomp, int
 }
 
 void
-FillPatchIterator::FillFromTwoLevels (Real time, int idx, int scomp, int dcomp, int ncomp)
+FillPatchIterator::FillFromTwoLevels (Real time, int idx, const Vector<int>& scomp,
+                                      const Vector<int>& dcomp, const Vector<int>& ncomp)
 {
     int ilev_fine = m_amrlevel.level;
     int ilev_crse = ilev_fine-1;
@@ -1084,26 +1099,37 @@ FillPatchIterator::FillFromTwoLevels (Real time, int idx, int scomp, int dcomp,
     Vector<Real> stime_crse;
     StateData& statedata_crse = crse_level.state[idx];
     statedata_crse.getData(smf_crse,stime_crse,time);
-    StateDataPhysBCFunct physbcf_crse(statedata_crse,scomp,geom_crse);
 
     Vector<MultiFab*> smf_fine;
     Vector<Real> stime_fine;
     StateData& statedata_fine = fine_level.state[idx];
     statedata_fine.getData(smf_fine,stime_fine,time);
-    StateDataPhysBCFunct physbcf_fine(statedata_fine,scomp,geom_fine);
 
     const StateDescriptor& desc = AmrLevel::desc_lst[idx];
 
-    amrex::FillPatchTwoLevels(m_fabs, time, 
-                              smf_crse, stime_crse, 
-                              smf_fine, stime_fine,
-                              scomp, dcomp, ncomp, 
-                              geom_crse, geom_fine,
-                              physbcf_crse, scomp,
-                              physbcf_fine, scomp,
-                              crse_level.fineRatio(), 
-                              desc.interp(scomp),
-                              desc.getBCs(),scomp);
+    const int nranges = scomp.size();
+    Vector<std::unique_ptr<StateDataPhysBCFunct> > physbcf_crse(nranges);
+    Vector<std::unique_ptr<StateDataPhysBCFunct> > physbcf_fine(nranges);
+    Vector<FillPatchItem> items;
+    items.reserve(nranges);
+
+    for (int i = 0; i < nranges; ++i)
+    {
+        physbcf_crse[i].reset(new StateDataPhysBCFunct(statedata_crse,scomp[i],geom_crse));
+        physbcf_fine[i].reset(new StateDataPhysBCFunct(statedata_fine,scomp[i],geom_fine));
+
+        items.emplace_back(m_fabs,
+                           smf_crse, stime_crse,
+                           smf_fine, stime_fine,
+                           scomp[i], dcomp[i], ncomp[i],
+                           *physbcf_crse[i], scomp[i],
+                           *physbcf_fine[i], scomp[i],
+                           desc.interp(scomp[i]),
+                           desc.getBCs(), scomp[i]);
+    }
+
+    amrex::FillPatchTwoLevels(items, time, geom_crse, geom_fine,
+                              crse_level.fineRatio());
 }
 
 static
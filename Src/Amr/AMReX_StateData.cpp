@@ -9,6 +9,7 @@
 #include <AMReX_StateDescriptor.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_Utility.H>
+#include <AMReX_AsyncOut.H>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -820,13 +821,21 @@ StateData::checkPoint (const std::string& name,
     {
        BL_ASSERT(new_data);
        std::string mf_fullpath_new(fullpathname + NewSuffix);
-       VisMF::Write(*new_data,mf_fullpath_new,how);
+       if (AsyncOut::UseAsyncOut()) {
+           VisMF::WriteAsyncOut(*new_data,mf_fullpath_new,how);
+       } else {
+           VisMF::Write(*new_data,mf_fullpath_new,how);
+       }
 
        if (dump_old)
        {
            BL_ASSERT(old_data);
            std::string mf_fullpath_old(fullpathname + OldSuffix);
-           VisMF::Write(*old_data,mf_fullpath_old,how);
+           if (AsyncOut::UseAsyncOut()) {
+               VisMF::WriteAsyncOut(*old_data,mf_fullpath_old,how);
+           } else {
+               VisMF::Write(*old_data,mf_fullpath_old,how);
+           }
        }
     }
 }
@@ -76,6 +76,7 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
 
     use_new_chop         = false;
     iterate_on_new_grids = true;
+    use_distributed_clustering = false;
 
     ParmParse pp("amr");
 
@@ -113,6 +114,7 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
 
     pp.query("n_proper",n_proper);
     pp.query("grid_eff",grid_eff);
+    pp.query("distributed_clustering",use_distributed_clustering);
     int cnt = pp.countval("n_error_buf");
     if (cnt > 0) {
         Vector<int> neb;
@@ -708,11 +710,23 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
         //
         // Create initial cluster containing all tagged points.
         //
+        // With distributed clustering each process only sees its own
+        // tags, and the boxes it builds from them are merged below.
+        //
 	Vector<IntVect> tagvec;
-	tags.collate(tagvec);
+        if (use_distributed_clustering) {
+            tags.local_collate(tagvec);
+        } else {
+            tags.collate(tagvec);
+        }
         tags.clear();
 
-        if (tagvec.size() > 0)
+        long numtags = tagvec.size();
+        if (use_distributed_clustering) {
+            ParallelDescriptor::ReduceLongSum(numtags);
+        }
+
+        if (numtags > 0)
         {
             //
             // Created new level, now generate efficient grids.
@@ -720,26 +734,36 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
             if ( !(useFixedCoarseGrids() && levc<useFixedUpToLevel()) ) {
                 new_finest = std::max(new_finest,levf);
 	    }
-            //
-            // Construct initial cluster.
-            //
-            ClusterList clist(&tagvec[0], tagvec.size());
-            if (use_new_chop)
+
+            BoxList new_bx;
+            if (tagvec.size() > 0)
             {
-               clist.new_chop(grid_eff);
-            } else {
-               clist.chop(grid_eff);
+                //
+                // Construct initial cluster.
+                //
+                ClusterList clist(&tagvec[0], tagvec.size());
+                if (use_new_chop)
+                {
+                   clist.new_chop(grid_eff);
+                } else {
+                   clist.chop(grid_eff);
+                }
+                BoxDomain bd;
+                bd.add(p_n[levc]);
+                clist.intersect(bd);
+                bd.clear();
+                //
+                // Efficient properly nested Clusters have been constructed
+                // now generate list of grids at level levf.
+                //
+                clist.boxList(new_bx);
             }
-            BoxDomain bd;
-            bd.add(p_n[levc]);
-            clist.intersect(bd);
-            bd.clear();
-            //
-            // Efficient properly nested Clusters have been constructed
-            // now generate list of grids at level levf.
-            //
-            BoxList new_bx;
-            clist.boxList(new_bx);
+
+            if (use_distributed_clustering) {
+                Vector<IntVect>().swap(tagvec);
+                MergeDistributedBoxLists(new_bx);
+            }
+
             new_bx.refine(bf_lev[levc]);
             new_bx.simplify();
             BL_ASSERT(new_bx.isDisjoint());
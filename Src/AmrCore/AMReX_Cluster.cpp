@@ -3,6 +3,7 @@
 #include <cmath>
 #include <AMReX_Cluster.H>
 #include <AMReX_BoxDomain.H>
+#include <AMReX_ParallelDescriptor.H>
 
 namespace amrex {
 
@@ -604,4 +605,120 @@ ClusterList::intersect (const BoxDomain& dom)
     }
 }
 
+namespace {
+
+void
+mergeBoxLists (BoxList& bl, Vector<Box>&& bxs)
+{
+    if (bxs.empty()) return;
+    if (bl.isEmpty()) {
+        bl = BoxList(std::move(bxs));
+    } else {
+        bl.join(bxs);
+        bl = amrex::removeOverlap(bl);
+    }
+}
+
+}
+
+void
+MergeDistributedBoxLists (BoxList& bl)
+{
+    BL_PROFILE("MergeDistributedBoxLists()");
+
+    if (!bl.isEmpty()) {
+        bl = amrex::removeOverlap(bl);
+    }
+
+#ifdef BL_USE_MPI
+    const int nprocs = ParallelDescriptor::NProcs();
+    if (nprocs == 1) return;
+
+    const int myproc = ParallelDescriptor::MyProc();
+    const int seqno  = ParallelDescriptor::SeqNum();
+    const auto szof_bx = Box::linearSize();
+    //
+    // Binary-tree reduction: in the round with stride s, process p with
+    // p % (2s) == s sends its list to p-s and drops out.
+    //
+    for (int stride = 1; stride < nprocs; stride *= 2)
+    {
+        if (myproc % (2*stride) == stride)
+        {
+            const int dst = myproc - stride;
+            Vector<char> send_buffer(bl.size()*szof_bx);
+            char* p = send_buffer.data();
+            for (const auto& b : bl) {
+                b.linearOut(p);
+                p += szof_bx;
+            }
+            long count = send_buffer.size();
+            ParallelDescriptor::Send(&count, 1, dst, seqno);
+            if (count > 0) {
+                ParallelDescriptor::Send(send_buffer.data(), count, dst, seqno);
+            }
+            bl.clear();
+            break;
+        }
+        else if (myproc % (2*stride) == 0 && myproc + stride < nprocs)
+        {
+            const int src = myproc + stride;
+            long count = 0;
+            ParallelDescriptor::Recv(&count, 1, src, seqno);
+            if (count > 0)
+            {
+                Vector<char> recv_buffer(count);
+                ParallelDescriptor::Recv(recv_buffer.data(), count, src, seqno);
+                Vector<Box> bxs(count/szof_bx);
+                char* p = recv_buffer.data();
+                for (auto& b : bxs) {
+                    b.linearIn(p);
+                    p += szof_bx;
+                }
+                mergeBoxLists(bl, std::move(bxs));
+            }
+        }
+    }
+    //
+    // Process 0 now holds the merged list.  Broadcast it back.
+    //
+    long count = 0;
+    Vector<char> buffer;
+    if (myproc == 0)
+    {
+        bl.simplify();
+        buffer.resize(bl.size()*szof_bx);
+        char* p = buffer.data();
+        for (const auto& b : bl) {
+            b.linearOut(p);
+            p += szof_bx;
+        }
+        count = buffer.size();
+    }
+
+    ParallelDescriptor::Bcast(&count, 1, 0);
+
+    if (count == 0) {
+        bl.clear();
+        return;
+    }
+
+    buffer.resize(count);
+    ParallelDescriptor::Bcast(buffer.data(), count, 0);
+
+    if (myproc != 0)
+    {
+        Vector<Box> bxs(count/szof_bx);
+        char* p = buffer.data();
+        for (auto& b : bxs) {
+            b.linearIn(p);
+            p += szof_bx;
+        }
+        bl = BoxList(std::move(bxs));
+    }
+#else
+    bl.simplify();
+#endif
+}
+
 }
@@ -40,13 +40,57 @@ namespace amrex
 	return crse_box.contains(fine_box_coarsened);
     }
 
-    void FillPatchSingleLevel (MultiFab& mf, Real time,
-			       const Vector<MultiFab*>& smf, const Vector<Real>& stime,
-			       int scomp, int dcomp, int ncomp,
-			       const Geometry& geom, PhysBCFunctBase& physbcf, int bcfcomp)
+    namespace {
+
+    // Valid region of dmf from smf, which has the same layout, at time
+    void InterpInTime (MultiFab& dmf, int dcomp, Real time,
+                       const Vector<MultiFab*>& smf, const Vector<Real>& stime,
+                       int scomp, int ncomp)
     {
-	BL_PROFILE("FillPatchSingleLevel");
+        if (smf.size() == 1)
+        {
+            MultiFab::Copy(dmf, *smf[0], scomp, dcomp, ncomp, 0);
+            return;
+        }
 
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(dmf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            const Real t0 = stime[0];
+            const Real t1 = stime[1];
+            auto const sfab0 = smf[0]->array(mfi);
+            auto const sfab1 = smf[1]->array(mfi);
+            auto       dfab  = dmf.array(mfi);
+
+            if (std::abs(t1-t0) > 1.e-16)
+            {
+                Real alpha = (t1-time)/(t1-t0);
+                Real beta = (time-t0)/(t1-t0);
+                AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+                {
+                    dfab(i,j,k,n+dcomp) = alpha*sfab0(i,j,k,n+scomp)
+                        +                  beta*sfab1(i,j,k,n+scomp);
+                });
+            }
+            else
+            {
+                AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+                {
+                    dfab(i,j,k,n+dcomp) = sfab0(i,j,k,n+scomp);
+                });
+            }
+        }
+    }
+
+    // FillPatchSingleLevel without the physical boundary conditions
+    void FillPatchSingleLevel_nobc (MultiFab& mf, Real time,
+                                    const Vector<MultiFab*>& smf, const Vector<Real>& stime,
+                                    int scomp, int dcomp, int ncomp,
+                                    const Geometry& geom)
+    {
 	BL_ASSERT(scomp+ncomp <= smf[0]->nComp());
 	BL_ASSERT(dcomp+ncomp <= mf.nComp());
 	BL_ASSERT(smf.size() == stime.size());
@@ -59,161 +103,292 @@ namespace amrex
 	else if (smf.size() == 2)
 	{
 	    BL_ASSERT(smf[0]->boxArray() == smf[1]->boxArray());
-	    MultiFab raii;
-	    MultiFab * dmf;
-	    int destcomp;
-	    bool sameba;
-	    if (mf.boxArray() == smf[0]->boxArray()) {
-		dmf = &mf;
-		destcomp = dcomp;
-		sameba = true;
-	    } else {
-		raii.define(smf[0]->boxArray(), smf[0]->DistributionMap(), ncomp, 0,
-                            MFInfo(), smf[0]->Factory());
-
-		dmf = &raii;
-		destcomp = 0;
-		sameba = false;
-	    }
-
-#ifdef _OPENMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-	    for (MFIter mfi(*dmf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+	    if (mf.boxArray() == smf[0]->boxArray())
 	    {
-		const Box& bx = mfi.tilebox();
-                const Real t0 = stime[0];
-                const Real t1 = stime[1];
-                auto const sfab0 = smf[0]->array(mfi);
-                auto const sfab1 = smf[1]->array(mfi);
-                auto       dfab  = dmf->array(mfi);
-
-                if (std::abs(t1-t0) > 1.e-16)
-                {
-                    Real alpha = (t1-time)/(t1-t0);
-                    Real beta = (time-t0)/(t1-t0);
-                    AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
-                    {
-                        dfab(i,j,k,n+destcomp) = alpha*sfab0(i,j,k,n+scomp)
-                            +                     beta*sfab1(i,j,k,n+scomp);
-                    });
-                }
-                else
-                {
-                    AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
-                    {
-                        dfab(i,j,k,n+destcomp) = sfab0(i,j,k,n+scomp);
-                    });
-                }
-	    }
-
-	    if (sameba)
-	    {
-		// Note that when sameba is true mf's BoxArray is nonoverlapping.
-		// So FillBoundary is safe.
+                InterpInTime(mf, dcomp, time, smf, stime, scomp, ncomp);
+		// Note that when the BoxArrays are the same mf's BoxArray is
+		// nonoverlapping.  So FillBoundary is safe.
 		mf.FillBoundary(dcomp,ncomp,geom.periodicity());
 	    }
 	    else
 	    {
+		MultiFab raii(smf[0]->boxArray(), smf[0]->DistributionMap(), ncomp, 0,
+                              MFInfo(), smf[0]->Factory());
+                InterpInTime(raii, 0, time, smf, stime, scomp, ncomp);
+
 		IntVect src_ngrow = IntVect::TheZeroVector();
 		IntVect dst_ngrow = mf.nGrowVect();
 
-		mf.ParallelCopy(*dmf, 0, dcomp, ncomp, src_ngrow, dst_ngrow, geom.periodicity());
+		mf.ParallelCopy(raii, 0, dcomp, ncomp, src_ngrow, dst_ngrow, geom.periodicity());
 	    }
 	}
 	else {
 	    amrex::Abort("FillPatchSingleLevel: high-order interpolation in time not implemented yet");
 	}
+    }
+
+    // Like FillPatchSingleLevel_nobc, but smf is copied first and
+    // interpolated in time on mf, so that no temporary is made on the
+    // BoxArray of smf.
+    void ParallelCopyInTime (MultiFab& mf, int dcomp, Real time,
+                             const Vector<MultiFab*>& smf, const Vector<Real>& stime,
+                             int scomp, int ncomp, const Geometry& geom)
+    {
+        BL_ASSERT(smf.size() == 1 || smf.size() == 2);
+
+        mf.ParallelCopy(*smf[0], scomp, dcomp, ncomp, IntVect{0}, mf.nGrowVect(), geom.periodicity());
+
+        if (smf.size() == 2 && std::abs(stime[1]-stime[0]) > 1.e-16)
+        {
+            MultiFab mf1(mf.boxArray(), mf.DistributionMap(), ncomp, mf.nGrowVect(),
+                         MFInfo(), mf.Factory());
+            mf1.ParallelCopy(*smf[1], scomp, 0, ncomp, IntVect{0}, mf.nGrowVect(), geom.periodicity());
+
+            const Real alpha = (stime[1]-time)/(stime[1]-stime[0]);
+            const Real beta = (time-stime[0])/(stime[1]-stime[0]);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.growntilebox();
+                auto const sfab1 = mf1.const_array(mfi);
+                auto       dfab  = mf.array(mfi);
+                AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+                {
+                    dfab(i,j,k,n+dcomp) = alpha*dfab(i,j,k,n+dcomp) + beta*sfab1(i,j,k,n);
+                });
+            }
+        }
+    }
+
+    // Do b's components come right after a's, in the same data?
+    bool SameSources (const Vector<MultiFab*>& smf_a, const Vector<Real>& st_a,
+                      const Vector<MultiFab*>& smf_b, const Vector<Real>& st_b,
+                      int scomp_a, int ncomp_a, int scomp_b)
+    {
+        return smf_a == smf_b && st_a == st_b && scomp_b == scomp_a + ncomp_a;
+    }
+
+    }
+
+    void FillPatchSingleLevel (MultiFab& mf, Real time,
+			       const Vector<MultiFab*>& smf, const Vector<Real>& stime,
+			       int scomp, int dcomp, int ncomp,
+			       const Geometry& geom, PhysBCFunctBase& physbcf, int bcfcomp)
+    {
+	BL_PROFILE("FillPatchSingleLevel");
+
+        FillPatchSingleLevel_nobc(mf, time, smf, stime, scomp, dcomp, ncomp, geom);
 
 	physbcf.FillBoundary(mf, dcomp, ncomp, time, bcfcomp);
     }
 
     namespace { void FillPatchTwoLevels_doit
-                            (MultiFab& mf, Real time,
-			     const Vector<MultiFab*>& cmf, const Vector<Real>& ct,
-			     const Vector<MultiFab*>& fmf, const Vector<Real>& ft,
-			     int scomp, int dcomp, int ncomp,
+                            (const Vector<FillPatchItem>& items, Real time,
 			     const Geometry& cgeom, const Geometry& fgeom,
-			     PhysBCFunctBase& cbc, int cbccomp,
-                             PhysBCFunctBase& fbc, int fbccomp,
 			     const IntVect& ratio,
-			     Interpolater* mapper,
-                             const Vector<BCRec>& bcs, int bcscomp,
-                             const InterpHook& pre_interp,
-                             const InterpHook& post_interp,
                              EB2::IndexSpace const* index_space)
     {
 	BL_PROFILE("FillPatchTwoLevels");
 
-	const IntVect& ngrow = mf.nGrowVect();
+        const int nitems = items.size();
+        if (nitems == 0) return;
 
-	if (ngrow.max() > 0 || mf.getBDKey() != fmf[0]->getBDKey())
-	{
-	    const InterpolaterBoxCoarsener& coarsener = mapper->BoxCoarsener(ratio);
+        NullInterpHook null_hook;
+
+        //
+        // Find the coarse patches each item needs.
+        //
+        Vector<FabArrayBase::FPinfo const*> fpcs(nitems, nullptr);
+        Vector<Box> fdomains(nitems);
+        for (int it = 0; it < nitems; ++it)
+        {
+            const FillPatchItem& item = items[it];
+            const MultiFab& mf = *item.mf;
+	    const IntVect& ngrow = mf.nGrowVect();
 
 	    Box fdomain = fgeom.Domain();
 	    fdomain.convert(mf.boxArray().ixType());
-	    Box fdomain_g(fdomain);
-	    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-		if (fgeom.isPeriodic(i)) {
-		    fdomain_g.grow(i,ngrow[i]);
-		}
-	    }
+            fdomains[it] = fdomain;
 
-	    const FabArrayBase::FPinfo& fpc = FabArrayBase::TheFPinfo(*fmf[0], mf, fdomain_g,
-                                                                      ngrow,
-                                                                      coarsener,
-                                                                      amrex::coarsen(fgeom.Domain(),ratio),
-                                                                      index_space);
-
-	    if ( ! fpc.ba_crse_patch.empty())
+	    if (ngrow.max() > 0 || mf.getBDKey() != item.fmf[0]->getBDKey())
 	    {
-		MultiFab mf_crse_patch(fpc.ba_crse_patch, fpc.dm_crse_patch, ncomp, 0, MFInfo(),
-                                       *fpc.fact_crse_patch);
+	        const InterpolaterBoxCoarsener& coarsener = item.mapper->BoxCoarsener(ratio);
+
+	        Box fdomain_g(fdomain);
+	        for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+		    if (fgeom.isPeriodic(i)) {
+		        fdomain_g.grow(i,ngrow[i]);
+		    }
+	        }
+
+	        const FabArrayBase::FPinfo& fpc = FabArrayBase::TheFPinfo(*item.fmf[0], mf, fdomain_g,
+                                                                          ngrow,
+                                                                          coarsener,
+                                                                          amrex::coarsen(fgeom.Domain(),ratio),
+                                                                          index_space);
+                if ( ! fpc.ba_crse_patch.empty()) {
+                    fpcs[it] = &fpc;
+                }
+            }
+        }
+
+        //
+        // Interpolate from the coarse level, one group of items that share
+        // the coarse patches at a time.
+        //
+        Vector<int> done(nitems, 0);
+        for (int it = 0; it < nitems; ++it)
+        {
+            if (fpcs[it] == nullptr || done[it]) continue;
+
+            const FabArrayBase::FPinfo& fpc = *fpcs[it];
+            const BoxArray& cba = items[it].cmf[0]->boxArray();
+            const DistributionMapping& cdm = items[it].cmf[0]->DistributionMap();
+
+            Vector<int> group;
+            Vector<int> offset;
+            int ncomp_tot = 0;
+            bool one_source = true;
+            for (int jt = it; jt < nitems; ++jt)
+            {
+                const FillPatchItem& item = items[jt];
+                if (fpcs[jt] == &fpc && !done[jt] &&
+                    item.cmf[0]->boxArray() == cba && item.cmf[0]->DistributionMap() == cdm)
+                {
+                    if (!group.empty()) {
+                        const FillPatchItem& prev = items[group.back()];
+                        one_source = one_source &&
+                            SameSources(prev.cmf, prev.ct, item.cmf, item.ct,
+                                        prev.scomp, prev.ncomp, item.scomp);
+                    }
+                    group.push_back(jt);
+                    offset.push_back(ncomp_tot);
+                    ncomp_tot += item.ncomp;
+                    done[jt] = 1;
+                }
+            }
+
+            // The coarse patches are kept from one call to the next.
+            MultiFab& mf_crse_patch = fpc.crsePatch(ncomp_tot);
 
-                mf_crse_patch.setDomainBndry(std::numeric_limits<Real>::quiet_NaN(), cgeom);
+            mf_crse_patch.setDomainBndry(std::numeric_limits<Real>::quiet_NaN(), 0, ncomp_tot, cgeom);
+
+            if (one_source)
+            {
+                const FillPatchItem& item = items[group[0]];
+                FillPatchSingleLevel_nobc(mf_crse_patch, time, item.cmf, item.ct,
+                                          item.scomp, 0, ncomp_tot, cgeom);
+            }
+            else
+            {
+                // One copy for each run of items with the same data,
+                // interpolated in time on the patches.
+                for (int ig = 0; ig < group.size(); )
+                {
+                    const FillPatchItem& first = items[group[ig]];
+                    int ncomp_run = first.ncomp;
+                    int jg = ig+1;
+                    for (; jg < group.size(); ++jg)
+                    {
+                        const FillPatchItem& prev = items[group[jg-1]];
+                        const FillPatchItem& item = items[group[jg]];
+                        if (!SameSources(prev.cmf, prev.ct, item.cmf, item.ct,
+                                         prev.scomp, prev.ncomp, item.scomp)) break;
+                        ncomp_run += item.ncomp;
+                    }
+                    ParallelCopyInTime(mf_crse_patch, offset[ig], time, first.cmf, first.ct,
+                                       first.scomp, ncomp_run, cgeom);
+                    ig = jg;
+                }
+            }
 
-		FillPatchSingleLevel(mf_crse_patch, time, cmf, ct, scomp, 0, ncomp, cgeom, cbc, cbccomp);
+            for (int ig = 0; ig < group.size(); ++ig) {
+                const FillPatchItem& item = items[group[ig]];
+                item.cbc->FillBoundary(mf_crse_patch, offset[ig], item.ncomp, time, item.cbccomp);
+            }
 
-		int idummy1=0, idummy2=0;
-		bool cc = fpc.ba_crse_patch.ixType().cellCentered();
-                ignore_unused(cc);
+	    int idummy1=0, idummy2=0;
+	    bool cc = fpc.ba_crse_patch.ixType().cellCentered();
+            ignore_unused(cc);
 #ifdef _OPENMP
 #pragma omp parallel if (cc && Gpu::notInLaunchRegion())
 #endif
+            {
+                Vector<BCRec> bcr;
+                for (MFIter mfi(mf_crse_patch); mfi.isValid(); ++mfi)
                 {
-                    Vector<BCRec> bcr(ncomp);
-                    for (MFIter mfi(mf_crse_patch); mfi.isValid(); ++mfi)
+                    FArrayBox& sfab = mf_crse_patch[mfi];
+                    int li = mfi.LocalIndex();
+                    int gi = fpc.dst_idxs[li];
+
+                    for (int ig = 0; ig < group.size(); ++ig)
                     {
-                        FArrayBox& sfab = mf_crse_patch[mfi];
-                        int li = mfi.LocalIndex();
-                        int gi = fpc.dst_idxs[li];
-                        FArrayBox& dfab = mf[gi];
+                        const FillPatchItem& item = items[group[ig]];
+                        const InterpHook& pre_interp  = item.pre_interp  ? *item.pre_interp  : null_hook;
+                        const InterpHook& post_interp = item.post_interp ? *item.post_interp : null_hook;
+                        const int scomp = offset[ig];
+                        const int dcomp = item.dcomp;
+                        const int ncomp = item.ncomp;
+
+                        FArrayBox& dfab = (*item.mf)[gi];
                         const Box& dbx = fpc.dst_boxes[li] & dfab.box();
 
-                        amrex::setBC(dbx,fdomain,bcscomp,0,ncomp,bcs,bcr);
+                        bcr.resize(ncomp);
+                        amrex::setBC(dbx,fdomains[group[ig]],item.bcscomp,0,ncomp,*item.bcs,bcr);
 
-                        pre_interp(sfab, sfab.box(), 0, ncomp);
+                        pre_interp(sfab, sfab.box(), scomp, ncomp);
 
-                        mapper->interp(sfab,
-                                       0,
-                                       dfab,
-                                       dcomp,
-                                       ncomp,
-                                       dbx,
-                                       ratio,
-                                       cgeom,
-                                       fgeom,
-                                       bcr,
-                                       idummy1, idummy2, RunOn::Gpu);
+                        item.mapper->interp(sfab,
+                                            scomp,
+                                            dfab,
+                                            dcomp,
+                                            ncomp,
+                                            dbx,
+                                            ratio,
+                                            cgeom,
+                                            fgeom,
+                                            bcr,
+                                            idummy1, idummy2, RunOn::Gpu);
 
                         post_interp(dfab, dbx, dcomp, ncomp);
                     }
                 }
-	    }
-	}
+            }
+        }
+
+        //
+        // Copy from the fine level, one run of items with adjacent
+        // components of the same destination and data at a time.
+        //
+        for (int it = 0; it < nitems; )
+        {
+            const FillPatchItem& first = items[it];
+            int ncomp_run = first.ncomp;
+            int jt = it+1;
+            for (; jt < nitems; ++jt)
+            {
+                const FillPatchItem& prev = items[jt-1];
+                const FillPatchItem& item = items[jt];
+                if (item.mf == first.mf && item.dcomp == prev.dcomp + prev.ncomp &&
+                    SameSources(prev.fmf, prev.ft, item.fmf, item.ft,
+                                prev.scomp, prev.ncomp, item.scomp))
+                {
+                    ncomp_run += item.ncomp;
+                } else {
+                    break;
+                }
+            }
 
-	FillPatchSingleLevel(mf, time, fmf, ft, scomp, dcomp, ncomp, fgeom, fbc, fbccomp);
+            FillPatchSingleLevel_nobc(*first.mf, time, first.fmf, first.ft,
+                                      first.scomp, first.dcomp, ncomp_run, fgeom);
+
+            for (; it < jt; ++it) {
+                const FillPatchItem& item = items[it];
+                item.fbc->FillBoundary(*item.mf, item.dcomp, item.ncomp, time, item.fbccomp);
+            }
+        }
     } }
 
     void FillPatchTwoLevels (MultiFab& mf, Real time,
@@ -235,9 +410,10 @@ namespace amrex
         EB2::IndexSpace const* index_space = nullptr;
 #endif
 
-        FillPatchTwoLevels_doit(mf,time,cmf,ct,fmf,ft,scomp,dcomp,ncomp,cgeom,fgeom,
-                                cbc,cbccomp,fbc,fbccomp,ratio,mapper,bcs,bcscomp,
-                                pre_interp,post_interp,index_space);
+        FillPatchTwoLevels_doit({FillPatchItem(mf,cmf,ct,fmf,ft,scomp,dcomp,ncomp,
+                                               cbc,cbccomp,fbc,fbccomp,mapper,bcs,bcscomp,
+                                               &pre_interp,&post_interp)},
+                                time,cgeom,fgeom,ratio,index_space);
     }
 
 #ifdef AMREX_USE_EB
@@ -255,9 +431,33 @@ namespace amrex
                              const InterpHook& pre_interp,
                              const InterpHook& post_interp)
     {
-        FillPatchTwoLevels_doit(mf,time,cmf,ct,fmf,ft,scomp,dcomp,ncomp,cgeom,fgeom,
-                                cbc,cbccomp,fbc,fbccomp,ratio,mapper,bcs,bcscomp,
-                                pre_interp,post_interp,&index_space);
+        FillPatchTwoLevels_doit({FillPatchItem(mf,cmf,ct,fmf,ft,scomp,dcomp,ncomp,
+                                               cbc,cbccomp,fbc,fbccomp,mapper,bcs,bcscomp,
+                                               &pre_interp,&post_interp)},
+                                time,cgeom,fgeom,ratio,&index_space);
+    }
+#endif
+
+    void FillPatchTwoLevels (const Vector<FillPatchItem>& items, Real time,
+                             const Geometry& cgeom, const Geometry& fgeom,
+                             const IntVect& ratio)
+    {
+#ifdef AMREX_USE_EB
+        EB2::IndexSpace const* index_space = EB2::TopIndexSpaceIfPresent();
+#else
+        EB2::IndexSpace const* index_space = nullptr;
+#endif
+
+        FillPatchTwoLevels_doit(items,time,cgeom,fgeom,ratio,index_space);
+    }
+
+#ifdef AMREX_USE_EB
+    void FillPatchTwoLevels (const Vector<FillPatchItem>& items, Real time,
+                             const EB2::IndexSpace& index_space,
+                             const Geometry& cgeom, const Geometry& fgeom,
+                             const IntVect& ratio)
+    {
+        FillPatchTwoLevels_doit(items,time,cgeom,fgeom,ratio,&index_space);
     }
 #endif
 
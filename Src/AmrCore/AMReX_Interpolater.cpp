@@ -10,15 +10,12 @@
 namespace amrex {
 
 //
-// PCInterp, NodeBilinear, and CellConservativeLinear are supported for all dimensions on cpu and gpu.
-//
-// CellConsertiveProtected only works in 2D and 3D on cpu.
+// PCInterp, NodeBilinear, CellConservativeLinear, CellConservativeProtected,
+// CellQuadratic and CellConservativeQuartic are supported for all dimensions on cpu and gpu.
 //
 // CellBilinear works in 1D, 2D and 3D on cpu.
 //
-// CellQuadratic only works in 2D on cpu.
-//
-// CellConservativeQuartic only works with ref ratio of 2 on cpu
+// CellConservativeQuartic only works with ref ratio of 2.
 //
 
 //
@@ -388,8 +385,8 @@ CellQuadratic::interp (const FArrayBox& crse,
                        const Geometry&  crse_geom,
                        const Geometry&  fine_geom,
                        Vector<BCRec> const&  bcr,
-                       int              actual_comp,
-                       int              actual_state,
+                       int              /*actual_comp*/,
+                       int              /*actual_state*/,
                        RunOn            runon)
 {
     BL_PROFILE("CellQuadratic::interp()");
@@ -399,84 +396,53 @@ CellQuadratic::interp (const FArrayBox& crse,
     //
     Box target_fine_region = fine_region & fine.box();
 
-    Box crse_bx(amrex::coarsen(target_fine_region,ratio));
-    Box fslope_bx(amrex::refine(crse_bx,ratio));
-    Box cslope_bx(crse_bx);
-    cslope_bx.grow(1);
-    BL_ASSERT(crse.box().contains(cslope_bx));
-    //
-    // Alloc temp space for coarse grid slopes: here we use 5
-    // instead of AMREX_SPACEDIM because of the x^2, y^2 and xy terms
-    //
-    long t_long = cslope_bx.numPts();
-    BL_ASSERT(t_long < INT_MAX);
-    int c_len = int(t_long);
+    const Box& cslope_bx = amrex::coarsen(target_fine_region,ratio);
+    BL_ASSERT(crse.box().contains(amrex::grow(cslope_bx,1)));
 
-    Vector<Real> cslope(5*c_len);
+    bool run_on_gpu = (runon == RunOn::Gpu && Gpu::inLaunchRegion());
 
-    int loslp = cslope_bx.index(crse_bx.smallEnd());
-    int hislp = cslope_bx.index(crse_bx.bigEnd());
+    Array4<Real const> const& crsearr = crse.const_array();
+    Array4<Real> const& finearr = fine.array();
 
-    t_long = cslope_bx.numPts();
-    BL_ASSERT(t_long < INT_MAX);
-    int cslope_vol = int(t_long);
-    int clo        = 1 - loslp;
-    int chi        = clo + cslope_vol - 1;
-    c_len          = hislp - loslp + 1;
-    //
-    // Alloc temp space for one strip of fine grid slopes: here we use 5
-    // instead of AMREX_SPACEDIM because of the x^2, y^2 and xy terms.
-    //
-    int dir;
-    int f_len = fslope_bx.longside(dir);
+    AsyncArray<BCRec> async_bcr(bcr.data(), (run_on_gpu) ? ncomp : 0);
+    BCRec const* bcrp = (run_on_gpu) ? async_bcr.data() : bcr.data();
 
-    Vector<Real> strip((5+2)*f_len);
+    const Box& ucrse_bx = amrex::grow(cslope_bx,1);
+    FArrayBox ucrse(ucrse_bx, ncomp);
+    Elixir ucrseeli;
+    if (run_on_gpu) ucrseeli = ucrse.elixir();
+    Array4<Real> const& ucrsearr = ucrse.array();
+
+    // component of slopefab : first and second derivatives of the first
+    //                         component in x, y, z, xx, yy, zz, xy, xz and yz
+    //                         order (x, y, xx, yy and xy in 2D), for each
+    //                         derivative all components come together.
+    const int nslopes = AMREX_SPACEDIM*(AMREX_SPACEDIM+3)/2;
+    FArrayBox slopefab(cslope_bx, ncomp*nslopes);
+    Elixir slopeeli;
+    if (run_on_gpu) slopeeli = slopefab.elixir();
+    Array4<Real> const& slopearr = slopefab.array();
 
-    Real* fstrip = strip.dataPtr();
-    Real* foff   = fstrip + f_len;
-    Real* fslope = foff + f_len;
-    //
-    // Get coarse and fine edge-centered volume coordinates.
-    //
-    Vector<Real> fvc[AMREX_SPACEDIM];
-    Vector<Real> cvc[AMREX_SPACEDIM];
-    for (dir = 0; dir < AMREX_SPACEDIM; dir++)
+    const Vector<Real>& vec_voff = amrex::ccinterp_compute_voff(cslope_bx, ratio, crse_geom, fine_geom);
+
+    AsyncArray<Real> async_voff(vec_voff.data(), (run_on_gpu) ? vec_voff.size() : 0);
+    Real const* voff = (run_on_gpu) ? async_voff.data() : vec_voff.data();
+
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (run_on_gpu, ucrse_bx, tbx,
     {
-        fine_geom.GetEdgeVolCoord(fvc[dir],target_fine_region,dir);
-        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
-    }
-    //
-    // Alloc tmp space for slope calc and to allow for vectorization.
-    //
-    Real* fdat        = fine.dataPtr(fine_comp);
-    const Real* cdat  = crse.dataPtr(crse_comp);
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* cblo   = crse_bx.loVect();
-    const int* cbhi   = crse_bx.hiVect();
-    const int* fslo   = fslope_bx.loVect();
-    const int* fshi   = fslope_bx.hiVect();
-    int slope_flag    = (do_limited_slope ? 1 : 0);
-    Vector<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
+        amrex::cellquadratic_flush(tbx, ucrsearr, crsearr, crse_comp, ncomp);
+    });
 
-#if (AMREX_SPACEDIM > 1)
-
-    amrex_cqinterp (fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),
-                   AMREX_ARLIM(fblo), AMREX_ARLIM(fbhi),
-                   &ncomp,AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-                   cdat,&clo,&chi,
-                   AMREX_ARLIM(cblo), AMREX_ARLIM(cbhi),
-                   fslo,fshi,
-                   cslope.dataPtr(),&c_len,fslope,fstrip,&f_len,foff,
-                   bc.dataPtr(), &slope_flag,
-                   AMREX_D_DECL(fvc[0].dataPtr(),fvc[1].dataPtr(),fvc[2].dataPtr()),
-                   AMREX_D_DECL(cvc[0].dataPtr(),cvc[1].dataPtr(),cvc[2].dataPtr()),
-                   &actual_comp,&actual_state);
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (run_on_gpu, cslope_bx, tbx,
+    {
+        amrex::cellquadratic_slopes(tbx, slopearr, ucrsearr, 0, ncomp, bcrp);
+    });
 
-#endif /*(AMREX_SPACEDIM > 1)*/
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (run_on_gpu, target_fine_region, tbx,
+    {
+        amrex::cellquadratic_interp(tbx, finearr, fine_comp, ncomp, slopearr, ucrsearr, 0,
+                                    voff, ratio);
+    });
 }
 
 PCInterp::~PCInterp () {}
@@ -607,8 +573,8 @@ CellConservativeProtected::interp (const FArrayBox& crse,
 }
 
 void
-CellConservativeProtected::protect (const FArrayBox& crse,
-                                    int              crse_comp,
+CellConservativeProtected::protect (const FArrayBox& /*crse*/,
+                                    int              /*crse_comp*/,
                                     FArrayBox&       fine,
                                     int              fine_comp,
                                     FArrayBox&       fine_state,
@@ -629,79 +595,38 @@ CellConservativeProtected::protect (const FArrayBox& crse,
     //
     Box target_fine_region = fine_region & fine.box();
 
-    //
-    // crse_bx is coarsening of target_fine_region, grown by 1.
-    //
-    Box crse_bx = CoarseBox(target_fine_region,ratio);
-
     //
     // cs_bx is coarsening of target_fine_region.
     //
-    Box cs_bx(crse_bx);
-    cs_bx.grow(-1);
+    const Box& cs_bx = amrex::coarsen(target_fine_region,ratio);
 
-    //
-    // Get coarse and fine edge-centered volume coordinates.
-    //
-    int dir;
-    Vector<Real> fvc[AMREX_SPACEDIM];
-    Vector<Real> cvc[AMREX_SPACEDIM];
-    for (dir = 0; dir < AMREX_SPACEDIM; dir++)
-    {
-        fine_geom.GetEdgeVolCoord(fvc[dir],target_fine_region,dir);
-        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
-    }
+    bool run_on_gpu = (runon == RunOn::Gpu && Gpu::inLaunchRegion());
 
-#if (AMREX_SPACEDIM == 2)
-    const int* cvcblo = crse_bx.loVect();
-    const int* fvcblo = target_fine_region.loVect();
+    Array4<Real> const& finearr = fine.array(fine_comp);
+    Array4<Real const> const& statearr = fine_state.const_array(state_comp);
 
-    int cvcbhi[AMREX_SPACEDIM];
-    int fvcbhi[AMREX_SPACEDIM];
+#if (AMREX_SPACEDIM == 3)
+    amrex::ignore_unused(crse_geom);
+    amrex::ignore_unused(fine_geom);
 
-    for (dir=0; dir<AMREX_SPACEDIM; dir++)
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (run_on_gpu, cs_bx, tbx,
     {
-        cvcbhi[dir] = cvcblo[dir] + cvc[dir].size() - 1;
-        fvcbhi[dir] = fvcblo[dir] + fvc[dir].size() - 1;
-    }
-#endif
+        amrex::cellconsprot_protect(tbx, finearr, statearr, ncomp, ratio);
+    });
+#else
+    //
+    // Fine and coarse cell volumes come from the edge-centered volume coordinates.
+    //
+    const Vector<Real>& vec_dv = amrex::cellconsprot_compute_dv(cs_bx, ratio, crse_geom, fine_geom);
 
-    Real* fdat       = fine.dataPtr(fine_comp);
-    Real* state_dat  = fine_state.dataPtr(state_comp);
-    const Real* cdat = crse.dataPtr(crse_comp);
-
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* slo    = fine_state.loVect();
-    const int* shi    = fine_state.hiVect();
-    const int* clo    = crse.loVect();
-    const int* chi    = crse.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* csbhi  = cs_bx.hiVect();
-    const int* csblo  = cs_bx.loVect();
-
-    Vector<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
+    AsyncArray<Real> async_dv(vec_dv.data(), (run_on_gpu) ? vec_dv.size() : 0);
+    Real const* dv = (run_on_gpu) ? async_dv.data() : vec_dv.data();
 
-#if (AMREX_SPACEDIM > 1)
-
-    amrex_protect_interp (fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),
-                         fblo, fbhi,
-                         cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),
-                         csblo, csbhi,
-#if (AMREX_SPACEDIM == 2)
-                         fvc[0].dataPtr(),fvc[1].dataPtr(),
-                         AMREX_ARLIM(fvcblo), AMREX_ARLIM(fvcbhi),
-                         cvc[0].dataPtr(),cvc[1].dataPtr(),
-                         AMREX_ARLIM(cvcblo), AMREX_ARLIM(cvcbhi),
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (run_on_gpu, cs_bx, tbx,
+    {
+        amrex::cellconsprot_protect(tbx, finearr, statearr, ncomp, ratio, cs_bx, dv);
+    });
 #endif
-                         state_dat, AMREX_ARLIM(slo), AMREX_ARLIM(shi),
-                         &ncomp,AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-                         bc.dataPtr());
-
-#endif /*(AMREX_SPACEDIM > 1)*/
-
 }
 
 CellConservativeQuartic::~CellConservativeQuartic () {}
@@ -735,73 +660,89 @@ CellConservativeQuartic::interp (const FArrayBox&  crse,
 				 const Geometry&   /* crse_geom */,
 				 const Geometry&   /* fine_geom */,
 				 Vector<BCRec> const&   bcr,
-				 int               actual_comp,
-				 int               actual_state,
+				 int               /*actual_comp*/,
+				 int               /*actual_state*/,
                                  RunOn             runon)
 {
     BL_PROFILE("CellConservativeQuartic::interp()");
     BL_ASSERT(bcr.size() >= ncomp);
-    BL_ASSERT(ratio[0]==2);
-#if (AMREX_SPACEDIM >= 2)
-    BL_ASSERT(ratio[0] == ratio[1]);
-#endif
-#if (AMREX_SPACEDIM == 3)
-    BL_ASSERT(ratio[1] == ratio[2]);
-#endif
+    amrex::ignore_unused(bcr);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ratio == 2,
+        "CellConservativeQuartic: only refinement ratio of 2 is supported");
 
     //
     // Make box which is intersection of fine_region and domain of fine.
     //
     Box target_fine_region = fine_region & fine.box();
+    BL_ASSERT(crse.box().contains(CoarseBox(target_fine_region,ratio)));
+
+    bool run_on_gpu = (runon == RunOn::Gpu && Gpu::inLaunchRegion());
+
+    Array4<Real const> const& crsearr = crse.const_array();
+    Array4<Real> const& finearr = fine.array();
+
     //
-    // crse_bx is coarsening of target_fine_region, grown by 2.
+    // The interpolation is separable.  It refines z (3D), then y (2D and
+    // 3D), then x, and tmpz and tmpy hold the partially refined data.  On
+    // the cpu, the region is done in slabs one coarse cell thick in the
+    // last direction so that these stay in cache.
     //
-    Box crse_bx = CoarseBox(target_fine_region,ratio);
-
-    Box crse_bx2(crse_bx);
-    crse_bx2.grow(-2);
-    Box fine_bx2 = amrex::refine(crse_bx2,ratio);
-
-    Real* fdat       = fine.dataPtr(fine_comp);
-    const Real* cdat = crse.dataPtr(crse_comp);
-
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* clo    = crse.loVect();
-    const int* chi    = crse.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* cblo   = crse_bx.loVect();
-    const int* cbhi   = crse_bx.hiVect();
-    const int* cb2lo  = crse_bx2.loVect();
-    const int* cb2hi  = crse_bx2.hiVect();
-    const int* fb2lo  = fine_bx2.loVect();
-    const int* fb2hi  = fine_bx2.hiVect();
-
-    Vector<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
+    const int sdir = AMREX_SPACEDIM-1;
+    const int send = target_fine_region.bigEnd(sdir);
+    const int slab = (run_on_gpu || AMREX_SPACEDIM == 1) ? target_fine_region.length(sdir)
+                                                         : ratio[sdir];
 
-    int ltmp = fb2hi[0]-fb2lo[0]+1;
-    Vector<Real> ftmp(ltmp);
+    FArrayBox tmpz, tmpy;
+    Elixir tmpzeli, tmpyeli;
 
-#if (AMREX_SPACEDIM >= 2)
-    ltmp = (cbhi[0]-cblo[0]+1)*ratio[1];
-    Vector<Real> ctmp(ltmp);
-#endif
+    Box fbx = target_fine_region;
+    for (int slo = target_fine_region.smallEnd(sdir); slo <= send; slo = fbx.bigEnd(sdir)+1)
+    {
+        fbx.setSmall(sdir, slo);
+        fbx.setBig(sdir, amrex::min(send, amrex::coarsen(slo,ratio[sdir])*ratio[sdir]+slab-1));
 
 #if (AMREX_SPACEDIM == 3)
-    ltmp = (cbhi[0]-cblo[0]+1)*(cbhi[1]-cblo[1]+1)*ratio[2];
-    Vector<Real> ctmp2(ltmp);
+        const Box& tmpz_bx = amrex::grow(amrex::coarsen(fbx,IntVect(2,2,1)), IntVect(2,2,0));
+        tmpz.resize(tmpz_bx, ncomp);
+        if (run_on_gpu) tmpzeli = tmpz.elixir();
+        Array4<Real> const& tmpzarr = tmpz.array();
+
+        AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (run_on_gpu, tmpz_bx, tbx,
+        {
+            amrex::cellconsquartic_interp_z(tbx, tmpzarr, 0, ncomp, crsearr, crse_comp);
+        });
+
+        Array4<Real const> const& ycrsearr = tmpz.const_array();
+        const int ycrse_comp = 0;
+#elif (AMREX_SPACEDIM == 2)
+        Array4<Real const> const& ycrsearr = crsearr;
+        const int ycrse_comp = crse_comp;
 #endif
 
-    amrex_quartinterp (fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),
-		      fblo, fbhi, fb2lo, fb2hi,
-		      cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),
-		      cblo, cbhi, cb2lo, cb2hi,
-		      &ncomp,
-		      AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-		      AMREX_D_DECL(ftmp.dataPtr(), ctmp.dataPtr(), ctmp2.dataPtr()),
-		      bc.dataPtr(),&actual_comp,&actual_state);
+#if (AMREX_SPACEDIM >= 2)
+        const Box& tmpy_bx = amrex::grow(amrex::coarsen(fbx,IntVect(AMREX_D_DECL(2,1,1))),
+                                         IntVect(AMREX_D_DECL(2,0,0)));
+        tmpy.resize(tmpy_bx, ncomp);
+        if (run_on_gpu) tmpyeli = tmpy.elixir();
+        Array4<Real> const& tmpyarr = tmpy.array();
+
+        AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (run_on_gpu, tmpy_bx, tbx,
+        {
+            amrex::cellconsquartic_interp_y(tbx, tmpyarr, 0, ncomp, ycrsearr, ycrse_comp);
+        });
+
+        Array4<Real const> const& xcrsearr = tmpy.const_array();
+        const int xcrse_comp = 0;
+#else
+        Array4<Real const> const& xcrsearr = crsearr;
+        const int xcrse_comp = crse_comp;
+#endif
+
+        AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (run_on_gpu, fbx, tbx,
+        {
+            amrex::cellconsquartic_interp_x(tbx, finearr, fine_comp, ncomp, xcrsearr, xcrse_comp);
+        });
+    }
 }
 
 }
@@ -4,6 +4,7 @@
 #include <AMReX_CArena.H>
 #include <AMReX_DArena.H>
 #include <AMReX_EArena.H>
+#include <AMReX_TArena.H>
 
 #include <AMReX.H>
 #include <AMReX_Print.H>
@@ -12,6 +13,7 @@
 #include <AMReX_Gpu.H>
 
 #include <sys/mman.h>
+#include <algorithm>
 
 namespace amrex {
 
@@ -28,6 +30,9 @@ namespace {
     long buddy_allocator_size = 0L;
     long the_arena_init_size = 0L;
     bool abort_on_out_of_gpu_memory = false;
+    bool use_thread_arena = false;
+    long thread_arena_max_block_size = 0L;
+    long thread_arena_cache_size = 0L;
 }
 
 const unsigned int Arena::align_size;
@@ -132,6 +137,9 @@ Arena::Initialize ()
     pp.query("buddy_allocator_size", buddy_allocator_size);
     pp.query("the_arena_init_size", the_arena_init_size);
     pp.query("abort_on_out_of_gpu_memory", abort_on_out_of_gpu_memory);
+    pp.query("use_thread_arena", use_thread_arena);
+    pp.query("thread_arena_max_block_size", thread_arena_max_block_size);
+    pp.query("thread_arena_cache_size", thread_arena_cache_size);
 
 #ifdef AMREX_USE_GPU
     if (use_buddy_allocator)
@@ -144,6 +152,13 @@ Arena::Initialize ()
         the_arena = new DArena(buddy_allocator_size, 512, ArenaInfo().SetPreferred());
     }
     else
+#else
+    if (use_thread_arena)
+    {
+        the_arena = new TArena(std::max(thread_arena_max_block_size,0L),
+                               std::max(thread_arena_cache_size,0L));
+    }
+    else
 #endif
     {
 #if defined(BL_COALESCE_FABS) || defined(AMREX_USE_GPU)
@@ -235,6 +250,27 @@ Arena::PrintUsage ()
 #endif
         }
     }
+    if (The_Arena()) {
+        TArena* p = dynamic_cast<TArena*>(The_Arena());
+        if (p) {
+            long min_megabytes = p->heap_space_used() / (1024*1024);
+            long max_megabytes = min_megabytes;
+            ParallelDescriptor::ReduceLongMin(min_megabytes, IOProc);
+            ParallelDescriptor::ReduceLongMax(max_megabytes, IOProc);
+            ArenaCounters c = p->counters();
+            long cnt[3] = {c.hits, c.misses, c.cross_thread_frees};
+            ParallelDescriptor::ReduceLongSum(cnt, 3, IOProc);
+#ifdef AMREX_USE_MPI
+            amrex::Print() << "[The         Arena] space (MB) used spread across MPI: ["
+                           << min_megabytes << " ... " << max_megabytes << "]\n";
+#else
+            amrex::Print() << "[The         Arena] space (MB): " << min_megabytes << "\n";
+#endif
+            amrex::Print() << "[The         Arena] cache hits: " << cnt[0]
+                           << ", misses: " << cnt[1]
+                           << ", cross-thread frees: " << cnt[2] << "\n";
+        }
+    }
     if (The_Device_Arena()) {
         CArena* p = dynamic_cast<CArena*>(The_Device_Arena());
         if (p) {
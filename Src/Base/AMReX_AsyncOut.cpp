@@ -0,0 +1,160 @@
+
+#include <AMReX_AsyncOut.H>
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_BLProfiler.H>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace amrex {
+namespace AsyncOut {
+
+namespace {
+    bool initialized = false;
+    bool s_use_async_out = false;
+
+    std::thread s_thread;
+    std::mutex s_mutex;
+    std::condition_variable s_cv_task;   // a new task or shutdown
+    std::condition_variable s_cv_done;   // a task has finished
+    std::deque<std::function<void()> > s_tasks;
+    bool s_shutdown = false;
+    long s_submitted = 0;   // ticket of the last submitted task
+    long s_completed = 0;   // ticket of the last finished task
+    long s_nerrors = 0;     // number of tasks that reported an error
+
+    void worker ()
+    {
+        while (true)
+        {
+            std::function<void()> f;
+            {
+                std::unique_lock<std::mutex> lock(s_mutex);
+                s_cv_task.wait(lock, [] () { return s_shutdown || !s_tasks.empty(); });
+                if (s_tasks.empty()) return;  // shutting down
+                f = std::move(s_tasks.front());
+                s_tasks.pop_front();
+            }
+
+            f();
+
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+                ++s_completed;
+            }
+            s_cv_done.notify_all();
+        }
+    }
+}
+
+void
+Initialize ()
+{
+    if (initialized) return;
+    initialized = true;
+
+    ParmParse pp("amrex");
+    pp.query("async_out", s_use_async_out);
+
+    if (s_use_async_out) {
+        s_shutdown = false;
+        s_thread = std::thread(worker);
+    }
+
+    amrex::ExecOnFinalize(AsyncOut::Finalize);
+}
+
+void
+Finalize ()
+{
+    if (!initialized) return;
+    initialized = false;
+
+    if (s_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_shutdown = true;
+        }
+        s_cv_task.notify_one();
+        s_thread.join();  // the worker drains the queue before it exits
+    }
+
+    s_use_async_out = false;
+    s_submitted = 0;
+    s_completed = 0;
+    s_nerrors = 0;
+}
+
+bool
+UseAsyncOut ()
+{
+    return s_use_async_out;
+}
+
+long
+Submit (std::function<void()>&& a_f)
+{
+    if (!s_use_async_out) {
+        a_f();
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_completed = ++s_submitted;
+        return s_submitted;
+    }
+
+    long ticket;
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_tasks.push_back(std::move(a_f));
+        ticket = ++s_submitted;
+    }
+    s_cv_task.notify_one();
+    return ticket;
+}
+
+long
+LastTicket ()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_submitted;
+}
+
+void
+Wait (long ticket)
+{
+    BL_PROFILE("AsyncOut::Wait()");
+    std::unique_lock<std::mutex> lock(s_mutex);
+    s_cv_done.wait(lock, [=] () { return s_completed >= ticket; });
+}
+
+bool
+Done (long ticket)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_completed >= ticket;
+}
+
+void
+Finish ()
+{
+    Wait(LastTicket());
+}
+
+void
+ReportError ()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    ++s_nerrors;
+}
+
+long
+NumErrors ()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_nerrors;
+}
+
+}}
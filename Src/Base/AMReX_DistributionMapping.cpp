@@ -10,6 +10,7 @@
 #endif
 #include <AMReX_VisMF.H>
 #include <AMReX_Utility.H>
+#include <AMReX_Machine.H>
 
 #include <iostream>
 #include <fstream>
@@ -26,6 +27,9 @@
 
 namespace {
 int flag_verbose_mapper;
+int graph_ngrow;
+int graph_npasses;
+double graph_tolerance;
 }
 
 namespace amrex {
@@ -75,6 +79,9 @@ DistributionMapping::strategy (DistributionMapping::Strategy how)
     case RRSFC:
         m_BuildMap = &DistributionMapping::RRSFCProcessorMap;
         break;
+    case GRAPH:
+        m_BuildMap = &DistributionMapping::GraphProcessorMap;
+        break;
     default:
         amrex::Error("Bad DistributionMapping::Strategy");
     }
@@ -116,6 +123,9 @@ DistributionMapping::Initialize ()
     max_efficiency   = 0.9;
     node_size        = 0;
     flag_verbose_mapper = 0;
+    graph_ngrow      = 1;
+    graph_npasses    = 4;
+    graph_tolerance  = 0.05;
 
     ParmParse pp("DistributionMapping");
 
@@ -125,6 +135,9 @@ DistributionMapping::Initialize ()
     pp.query("sfc_threshold",       sfc_threshold);
     pp.query("node_size",           node_size);
     pp.query("verbose_mapper",      flag_verbose_mapper);
+    pp.query("graph_ngrow",         graph_ngrow);
+    pp.query("graph_npasses",       graph_npasses);
+    pp.query("graph_tolerance",     graph_tolerance);
 
     std::string theStrategy;
 
@@ -146,6 +159,10 @@ DistributionMapping::Initialize ()
         {
             strategy(RRSFC);
         }
+        else if (theStrategy == "GRAPH")
+        {
+            strategy(GRAPH);
+        }
         else
         {
             std::string msg("Unknown strategy: ");
@@ -1327,8 +1344,321 @@ DistributionMapping::RRSFCProcessorMap (const BoxArray&          boxes,
     RRSFCDoIt(boxes,nprocs);
 }
 
+namespace
+{
+    using GraphEdges = Vector<Vector<std::pair<int,long> > >;
+
+    //
+    // The communication graph: box i and box j are connected if the ghost
+    // region of one intersects the valid region of the other, and the edge
+    // weight is the number of ghost cells they exchange in FillBoundary.
+    //
+    void
+    BuildCommGraph (const BoxArray& boxes, int ngrow, GraphEdges& adj)
+    {
+        BL_PROFILE("DistributionMapping::BuildCommGraph()");
+
+        const int N = boxes.size();
+        adj.clear();
+        adj.resize(N);
+
+        std::vector< std::pair<int,Box> > isects;
+
+        for (int i = 0; i < N; ++i)
+        {
+            boxes.intersections(amrex::grow(boxes[i],ngrow), isects);
+            for (const auto& is : isects)
+            {
+                const int j = is.first;
+                if (j != i) {
+                    const long ncells = is.second.numPts();
+                    adj[i].push_back(std::make_pair(j,ncells));
+                    adj[j].push_back(std::make_pair(i,ncells));
+                }
+            }
+        }
+
+        // Combine the two directions of each edge.
+        for (auto& a : adj)
+        {
+            std::sort(a.begin(), a.end());
+            int n = 0;
+            for (int k = 0, M = a.size(); k < M; ++k)
+            {
+                if (n > 0 && a[n-1].first == a[k].first) {
+                    a[n-1].second += a[k].second;
+                } else {
+                    a[n++] = a[k];
+                }
+            }
+            a.resize(n);
+        }
+    }
+
+    //
+    // Partition the boxes in ids into capacity.size() parts so that the
+    // weight of part p is proportional to capacity[p] and the total weight
+    // of the cut edges is small.  Only boxes whose group equals gid take
+    // part.  On return, part[ids[k]] is in [0,capacity.size()).
+    //
+    // The initial partition cuts the boxes in Morton order.  It is then
+    // improved by greedy boundary refinement: a box moves to the
+    // neighboring part it is most strongly connected to if that reduces the
+    // cut and keeps that part within the load tolerance.
+    //
+    void
+    GraphPartition (const BoxArray&          boxes,
+                    const std::vector<long>& wgts,
+                    const GraphEdges&        adj,
+                    const std::vector<int>&  ids,
+                    const Vector<int>&       group,
+                    int                      gid,
+                    const std::vector<int>&  capacity,
+                    Vector<int>&             part)
+    {
+        const int nparts = capacity.size();
+        if (ids.empty() || nparts == 0) return;
+
+        if (nparts == 1) {
+            for (int i : ids) part[i] = 0;
+            return;
+        }
+
+        std::vector<SFCToken> tokens;
+        tokens.reserve(ids.size());
+        int maxijk = 0;
+        for (int i : ids)
+        {
+            const Box& bx = boxes[i];
+            tokens.push_back(SFCToken(i,bx.smallEnd(),wgts[i]));
+            const SFCToken& token = tokens.back();
+            AMREX_D_TERM(maxijk = std::max(maxijk, token.m_idx[0]);,
+                         maxijk = std::max(maxijk, token.m_idx[1]);,
+                         maxijk = std::max(maxijk, token.m_idx[2]););
+        }
+        int m = 0;
+        for ( ; (1 << m) <= maxijk; ++m) {
+            ;  // do nothing
+        }
+        SFCToken::MaxPower = m;
+        std::sort(tokens.begin(), tokens.end(), SFCToken::Compare());
+
+        double totwgt = 0;
+        for (int i : ids) totwgt += wgts[i];
+        const double totcap = std::accumulate(capacity.begin(), capacity.end(), 0.0);
+
+        std::vector<double> target(nparts);
+        for (int p = 0; p < nparts; ++p) {
+            target[p] = totwgt*capacity[p]/totcap;
+        }
+
+        std::vector<double> load(nparts, 0.0);
+        std::vector<int> count(nparts, 0);
+        {
+            int p = 0;
+            double bound = target[0];
+            double cum = 0;
+            for (const auto& tok : tokens)
+            {
+                const long w = wgts[tok.m_box];
+                if (p < nparts-1 && count[p] > 0 && cum + 0.5*w > bound) {
+                    ++p;
+                    bound += target[p];
+                }
+                part[tok.m_box] = p;
+                load[p] += w;
+                ++count[p];
+                cum += w;
+            }
+        }
+
+        std::vector<double> maxload(nparts);
+        for (int p = 0; p < nparts; ++p) {
+            maxload[p] = std::max(target[p]*(1.0+graph_tolerance), load[p]);
+        }
+
+        std::map<int,long> conn;
+        for (int ipass = 0; ipass < graph_npasses; ++ipass)
+        {
+            int nmoved = 0;
+            for (const auto& tok : tokens)
+            {
+                const int i = tok.m_box;
+                const int p = part[i];
+                const long w = wgts[i];
+                if (count[p] == 1) continue;
+
+                conn.clear();
+                long internal = 0;
+                for (const auto& e : adj[i])
+                {
+                    if (group[e.first] != gid) continue;
+                    const int q = part[e.first];
+                    if (q == p) {
+                        internal += e.second;
+                    } else {
+                        conn[q] += e.second;
+                    }
+                }
+
+                int best = -1;
+                long bestgain = 0;
+                for (const auto& c : conn)
+                {
+                    const long gain = c.second - internal;
+                    if (gain > bestgain && load[c.first] + w <= maxload[c.first]) {
+                        best = c.first;
+                        bestgain = gain;
+                    }
+                }
+
+                if (best >= 0)
+                {
+                    part[i] = best;
+                    load[p] -= w;
+                    load[best] += w;
+                    --count[p];
+                    ++count[best];
+                    ++nmoved;
+                }
+            }
+            if (nmoved == 0) break;
+        }
+    }
+}
+
+void
+DistributionMapping::GraphProcessorMapDoIt (const BoxArray&          boxes,
+                                            const std::vector<long>& wgts,
+                                            int                   /*   nprocs */)
+{
+    if (flag_verbose_mapper) {
+        Print() << "DM: GraphProcessorMapDoIt called..." << std::endl;
+    }
+
+    BL_PROFILE("DistributionMapping::GraphProcessorMapDoIt()");
+
+    const int nprocs = ParallelContext::NProcsSub();
+    const int N = boxes.size();
+
+    GraphEdges adj;
+    BuildCommGraph(boxes, graph_ngrow, adj);
+    //
+    // Group the processes by node.
+    //
+    Vector<int> rank_node(nprocs, 0);
+    {
+        const Vector<int>& ids = machine::node_ids();
+        for (int r = 0; r < nprocs; ++r) {
+            rank_node[r] = ids[ParallelContext::local_to_global_rank(r)];
+        }
+    }
+
+    std::map<int,Vector<int> > node_ranks;
+    for (int r = 0; r < nprocs; ++r) {
+        node_ranks[rank_node[r]].push_back(r);
+    }
+    const int nnodes = node_ranks.size();
+
+    std::vector<int> node_cap;
+    Vector<Vector<int> > ranks_on_node;
+    for (auto& kv : node_ranks) {
+        node_cap.push_back(kv.second.size());
+        ranks_on_node.push_back(std::move(kv.second));
+    }
+
+    if (flag_verbose_mapper) {
+        Print() << "  (nprocs, nnodes) = (" << nprocs << ", " << nnodes << ")\n";
+    }
+    //
+    // First cut the graph across nodes, then across the ranks of each node.
+    //
+    std::vector<int> all_ids(N);
+    std::iota(all_ids.begin(), all_ids.end(), 0);
+
+    Vector<int> zeros(N, 0);
+    Vector<int> node_of_box(N, 0);
+    GraphPartition(boxes, wgts, adj, all_ids, zeros, 0, node_cap, node_of_box);
+
+    std::vector<std::vector<int> > node_boxes(nnodes);
+    for (int i = 0; i < N; ++i) {
+        node_boxes[node_of_box[i]].push_back(i);
+    }
+
+    Vector<int> rank_of_box(N, 0);
+    for (int n = 0; n < nnodes; ++n)
+    {
+        std::vector<int> cap(ranks_on_node[n].size(), 1);
+        GraphPartition(boxes, wgts, adj, node_boxes[n], node_of_box, n, cap, rank_of_box);
+        for (int i : node_boxes[n]) {
+            const int r = ranks_on_node[n][rank_of_box[i]];
+            m_ref->m_pmap[i] = ParallelContext::local_to_global_rank(r);
+        }
+    }
+
+    if (verbose)
+    {
+        std::vector<long> rank_wgt(nprocs, 0);
+        long cut_node = 0, cut_rank = 0, total = 0;
+        for (int i = 0; i < N; ++i)
+        {
+            rank_wgt[ParallelContext::global_to_local_rank(m_ref->m_pmap[i])] += wgts[i];
+            for (const auto& e : adj[i])
+            {
+                total += e.second;
+                if (node_of_box[i] != node_of_box[e.first]) {
+                    cut_node += e.second;
+                } else if (m_ref->m_pmap[i] != m_ref->m_pmap[e.first]) {
+                    cut_rank += e.second;
+                }
+            }
+        }
+        const Real sum_wgt = std::accumulate(rank_wgt.begin(), rank_wgt.end(), 0.0);
+        const Real max_wgt = *std::max_element(rank_wgt.begin(), rank_wgt.end());
+        amrex::Print() << "GRAPH efficiency: " << (sum_wgt/(nprocs*max_wgt))
+                       << ", ghost cells crossing nodes: " << cut_node/2
+                       << ", crossing ranks within a node: " << cut_rank/2
+                       << ", total: " << total/2 << '\n';
+    }
+}
+
+void
+DistributionMapping::GraphProcessorMap (const BoxArray& boxes,
+                                        int             nprocs)
+{
+    BL_ASSERT(boxes.size() > 0);
+
+    m_ref->clear();
+    m_ref->m_pmap.resize(boxes.size());
+
+    std::vector<long> wgts;
+
+    wgts.reserve(boxes.size());
+
+    for (int i = 0, N = boxes.size(); i < N; ++i)
+    {
+        wgts.push_back(boxes[i].volume());
+    }
+
+    GraphProcessorMapDoIt(boxes,wgts,nprocs);
+}
+
+void
+DistributionMapping::GraphProcessorMap (const BoxArray&          boxes,
+                                        const std::vector<long>& wgts,
+                                        int                      nprocs)
+{
+    BL_ASSERT(boxes.size() > 0);
+    BL_ASSERT(boxes.size() == static_cast<int>(wgts.size()));
+
+    m_ref->clear();
+    m_ref->m_pmap.resize(wgts.size());
+
+    GraphProcessorMapDoIt(boxes,wgts,nprocs);
+}
+
 DistributionMapping
-DistributionMapping::makeKnapSack (const Vector<Real>& rcost)
+DistributionMapping::makeKnapSack (const Vector<Real>& rcost, int nmax)
 {
     BL_PROFILE("makeKnapSack");
 
@@ -1346,7 +1676,7 @@ DistributionMapping::makeKnapSack (const Vector<Real>& rcost)
     int nprocs = ParallelContext::NProcsSub();
     Real eff;
 
-    r.KnapSackProcessorMap(cost, nprocs, &eff, true);
+    r.KnapSackProcessorMap(cost, nprocs, &eff, true, nmax);
 
     return r;
 }
@@ -1459,6 +1789,66 @@ DistributionMapping::makeSFC (const MultiFab& weight, bool sort)
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeSFC (const Vector<Real>& rcost, const BoxArray& ba, bool sort)
+{
+    BL_PROFILE("makeSFC");
+
+    AMREX_ASSERT(rcost.size() == ba.size());
+
+    DistributionMapping r;
+
+    Vector<long> cost(rcost.size());
+
+    Real wmax = *std::max_element(rcost.begin(), rcost.end());
+    Real scale = (wmax == 0) ? 1.e9 : 1.e9/wmax;
+
+    for (int i = 0; i < rcost.size(); ++i) {
+        cost[i] = long(rcost[i]*scale) + 1L;
+    }
+
+    int nprocs = ParallelContext::NProcsSub();
+
+    r.SFCProcessorMap(ba, cost, nprocs, sort);
+
+    return r;
+}
+
+DistributionMapping
+DistributionMapping::makeGraph (const MultiFab& weight)
+{
+    DistributionMapping r;
+
+    Vector<long> cost(weight.size());
+#ifdef BL_USE_MPI
+    {
+	Vector<Real> rcost(cost.size(), 0.0);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+	for (MFIter mfi(weight); mfi.isValid(); ++mfi) {
+	    int i = mfi.index();
+	    rcost[i] = weight[mfi].sum(mfi.validbox(),0);
+	}
+
+	ParallelAllReduce::Sum(&rcost[0], rcost.size(), ParallelContext::CommunicatorSub());
+
+	Real wmax = *std::max_element(rcost.begin(), rcost.end());
+        Real scale = (wmax == 0) ? 1.e9 : 1.e9/wmax;
+
+	for (int i = 0; i < rcost.size(); ++i) {
+	    cost[i] = long(rcost[i]*scale) + 1L;
+	}
+    }
+#endif
+
+    int nprocs = ParallelContext::NProcsSub();
+
+    r.GraphProcessorMap(weight.boxArray(), cost, nprocs);
+
+    return r;
+}
+
 std::vector<std::vector<int> >
 DistributionMapping::makeSFC (const BoxArray& ba, bool use_box_vol)
 {
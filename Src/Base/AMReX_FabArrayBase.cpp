@@ -1,6 +1,7 @@
 
 #include <algorithm>
 #include <AMReX_FabArrayBase.H>
+#include <AMReX_MultiFab.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
 #include <AMReX_Geometry.H>
@@ -24,6 +25,7 @@ namespace amrex {
 // Set default values in Initialize()!!!
 //
 int     FabArrayBase::MaxComp;
+bool    FabArrayBase::use_persistent_comm;
 
 #if defined(AMREX_USE_GPU) && defined(AMREX_USE_GPU_PRAGMA)
 
@@ -90,6 +92,7 @@ FabArrayBase::Initialize ()
     // Set default values here!!!
     //
     FabArrayBase::MaxComp           = 25;
+    FabArrayBase::use_persistent_comm = false;
 
     ParmParse pp("fabarray");
 
@@ -111,6 +114,7 @@ FabArrayBase::Initialize ()
     }
 
     pp.query("maxcomp",             FabArrayBase::MaxComp);
+    pp.query("use_persistent_comm", FabArrayBase::use_persistent_comm);
 
     if (MaxComp < 1) {
         MaxComp = 1;
@@ -982,6 +986,21 @@ FabArrayBase::FB::define_epo (const FabArrayBase& fa)
 FabArrayBase::FB::~FB ()
 {}
 
+#ifdef BL_USE_MPI
+FabArrayBase::PersistentPlan::~PersistentPlan ()
+{
+    BL_ASSERT(!in_use);
+    for (auto& req : recv_reqs) {
+        BL_MPI_REQUIRE( MPI_Request_free(&req) );
+    }
+    for (auto& req : send_reqs) {
+        BL_MPI_REQUIRE( MPI_Request_free(&req) );
+    }
+    if (the_recv_data) The_FA_Arena()->free(the_recv_data);
+    if (the_send_data) The_FA_Arena()->free(the_send_data);
+}
+#endif
+
 void
 FabArrayBase::flushFB (bool no_assertion) const
 {
@@ -1134,9 +1153,33 @@ FabArrayBase::FPinfo::bytes () const
     long cnt = sizeof(FabArrayBase::FPinfo);
     cnt += sizeof(Box) * (ba_crse_patch.capacity() + dst_boxes.capacity());
     cnt += sizeof(int) * (dm_crse_patch.capacity() + dst_idxs.capacity());
+    if (mf_crse_patch) {
+        for (MFIter mfi(*mf_crse_patch); mfi.isValid(); ++mfi) {
+            cnt += (*mf_crse_patch)[mfi].nBytesOwned();
+        }
+    }
     return cnt;
 }
 
+MultiFab&
+FabArrayBase::FPinfo::crsePatch (int ncomp) const
+{
+    if (mf_crse_patch == nullptr || mf_crse_patch->nComp() < ncomp)
+    {
+#ifdef AMREX_MEM_PROFILING
+        m_FPinfo_stats.bytes -= bytes();
+#endif
+        mf_crse_patch.reset();
+        mf_crse_patch.reset(new MultiFab(ba_crse_patch, dm_crse_patch, ncomp, 0,
+                                         MFInfo(), *fact_crse_patch));
+#ifdef AMREX_MEM_PROFILING
+        m_FPinfo_stats.bytes += bytes();
+        m_FPinfo_stats.bytes_hwm = std::max(m_FPinfo_stats.bytes_hwm, m_FPinfo_stats.bytes);
+#endif
+    }
+    return *mf_crse_patch;
+}
+
 const FabArrayBase::FPinfo&
 FabArrayBase::TheFPinfo (const FabArrayBase& srcfa,
                          const FabArrayBase& dstfa,
@@ -1231,6 +1274,22 @@ FabArrayBase::flushFPinfo (bool no_assertion)
     }
 }
 
+void
+FabArrayBase::flushFPinfoCache ()
+{
+    for (FPinfoCacheIter it = m_TheFillPatchCache.begin(); it != m_TheFillPatchCache.end(); ++it)
+    {
+	if (it->first == it->second->m_dstbdk) {
+	    m_FPinfo_stats.recordErase(it->second->m_nuse);
+	    delete it->second;
+	}
+    }
+    m_TheFillPatchCache.clear();
+#ifdef AMREX_MEM_PROFILING
+    m_FPinfo_stats.bytes = 0L;
+#endif
+}
+
 FabArrayBase::CFinfo::CFinfo (const FabArrayBase& finefa,
                               const Geometry&     finegm,
                               const IntVect&      ng,
@@ -1372,6 +1431,7 @@ FabArrayBase::Finalize ()
     FabArrayBase::flushFBCache();
     FabArrayBase::flushCPCache();
     FabArrayBase::flushTileArrayCache();
+    FabArrayBase::flushFPinfoCache();
 
     if (ParallelDescriptor::IOProcessor() && amrex::system::verbose > 1) {
 	m_FA_stats.print();
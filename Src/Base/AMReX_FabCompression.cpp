@@ -0,0 +1,369 @@
+
+#include <AMReX_FabCompression.H>
+#include <AMReX.H>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace amrex {
+namespace FabCompression {
+
+namespace {
+
+    using uchar = unsigned char;
+
+    //! An unsigned integer with the size of Real
+    using RealBits = std::conditional<sizeof(Real) == 8, uint64_t, uint32_t>::type;
+
+    //
+    // A small LZ77 coder using the LZ4 block layout:  each sequence is a
+    // token (4 bits literal length, 4 bits match length - 4), the literal
+    // length continuation, the literals, a 2-byte offset and the match
+    // length continuation.  The last sequence has literals only.
+    //
+    constexpr int  hash_log   = 14;
+    constexpr long min_match  = 4;
+    constexpr long max_offset = 65535;
+
+    inline uint32_t read32 (const uchar* p) noexcept
+    {
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    inline uint32_t hash32 (uint32_t v) noexcept
+    {
+        return (v * 2654435761u) >> (32 - hash_log);
+    }
+
+    inline void put_length (Vector<char>& out, long len)
+    {
+        while (len >= 255) {
+            out.push_back(static_cast<char>(255));
+            len -= 255;
+        }
+        out.push_back(static_cast<char>(len));
+    }
+
+    inline void put_literals (Vector<char>& out, const uchar* lit, long nlit, long mlen)
+    {
+        const long m = mlen - min_match;
+        out.push_back(static_cast<char>((std::min(nlit,15L) << 4) | std::min(std::max(m,0L),15L)));
+        if (nlit >= 15) put_length(out, nlit-15);
+        out.insert(out.end(), reinterpret_cast<const char*>(lit),
+                   reinterpret_cast<const char*>(lit)+nlit);
+    }
+
+    void lz_compress (const uchar* in, long n, Vector<char>& out)
+    {
+        std::vector<long> table(1 << hash_log, -1L);
+        long ip = 0, anchor = 0;
+        const long mflimit    = n - 12;  // the last match must start before this
+        const long matchlimit = n - 5;   // and end before this
+
+        while (ip < mflimit)
+        {
+            const uint32_t seq = read32(in+ip);
+            const uint32_t h = hash32(seq);
+            const long ref = table[h];
+            table[h] = ip;
+
+            if (ref >= 0 && ip-ref <= max_offset && read32(in+ref) == seq)
+            {
+                long mlen = min_match;
+                while (ip+mlen < matchlimit && in[ref+mlen] == in[ip+mlen]) {
+                    ++mlen;
+                }
+
+                put_literals(out, in+anchor, ip-anchor, mlen);
+                const long off = ip-ref;
+                out.push_back(static_cast<char>(off & 0xff));
+                out.push_back(static_cast<char>(off >> 8));
+                if (mlen-min_match >= 15) put_length(out, mlen-min_match-15);
+
+                ip += mlen;
+                anchor = ip;
+            }
+            else
+            {
+                // Skip faster through data that do not compress.
+                ip += 1 + ((ip-anchor) >> 6);
+            }
+        }
+
+        put_literals(out, in+anchor, n-anchor, min_match);
+    }
+
+    bool lz_decompress (const uchar* in, long nin, uchar* out, long nout) noexcept
+    {
+        long ip = 0, op = 0;
+        while (ip < nin)
+        {
+            const uchar token = in[ip++];
+
+            long nlit = token >> 4;
+            if (nlit == 15) {
+                uchar b;
+                do {
+                    if (ip >= nin) return false;
+                    b = in[ip++];
+                    nlit += b;
+                } while (b == 255);
+            }
+            if (ip+nlit > nin || op+nlit > nout) return false;
+            std::memcpy(out+op, in+ip, nlit);
+            ip += nlit;
+            op += nlit;
+
+            if (ip >= nin) break;  // the last sequence has no match
+
+            if (ip+2 > nin) return false;
+            const long off = long(in[ip]) | (long(in[ip+1]) << 8);
+            ip += 2;
+            if (off == 0 || off > op) return false;
+
+            long mlen = token & 15;
+            if (mlen == 15) {
+                uchar b;
+                do {
+                    if (ip >= nin) return false;
+                    b = in[ip++];
+                    mlen += b;
+                } while (b == 255);
+            }
+            mlen += min_match;
+            if (op+mlen > nout) return false;
+
+            if (off >= mlen) {
+                std::memcpy(out+op, out+op-off, mlen);
+            } else {
+                for (long k = 0; k < mlen; ++k) {  // overlapping copy
+                    out[op+k] = out[op-off+k];
+                }
+            }
+            op += mlen;
+        }
+        return op == nout;
+    }
+
+    template <class T>
+    inline void put_value (Vector<char>& out, T v)
+    {
+        const char* p = reinterpret_cast<const char*>(&v);
+        out.insert(out.end(), p, p+sizeof(T));
+    }
+
+    template <class T>
+    inline T get_value (const char*& p)
+    {
+        T v;
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return v;
+    }
+
+    //
+    // Quantize to a uniform grid with spacing just under 2*tol, so that the
+    // reconstruction error is at most tol, then zigzag-delta-varint code the
+    // integers and LZ77 the bytes.  Returns false if the data are not
+    // suitable (non-finite values, or tol too small relative to the values
+    // to be represented accurately).
+    //
+    bool compress_lossy (Real tol, const Real* src, long n, Vector<char>& out)
+    {
+        double mn =  std::numeric_limits<double>::max();
+        double mx = -std::numeric_limits<double>::max();
+        for (long i = 0; i < n; ++i) {
+            const double x = src[i];
+            if (!std::isfinite(x)) return false;
+            mn = std::min(mn, x);
+            mx = std::max(mx, x);
+        }
+        if (n == 0) { mn = mx = 0.0; }
+
+        const double step = 1.9 * static_cast<double>(tol);
+        const double amax = std::max(std::abs(mn), std::abs(mx));
+        if (!(step > 1.e4 * std::numeric_limits<Real>::epsilon() * amax)) return false;
+
+        std::vector<uchar> var;
+        var.reserve(n);
+        int64_t prev = 0;
+        for (long i = 0; i < n; ++i) {
+            const int64_t q = std::llround((static_cast<double>(src[i]) - mn) / step);
+            const int64_t d = q - prev;
+            prev = q;
+            uint64_t u = (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+            while (u >= 0x80) {
+                var.push_back(static_cast<uchar>(u | 0x80));
+                u >>= 7;
+            }
+            var.push_back(static_cast<uchar>(u));
+        }
+
+        out.push_back(static_cast<char>(Lossy));
+        put_value(out, mn);
+        put_value(out, step);
+        put_value(out, static_cast<int64_t>(var.size()));
+        lz_compress(var.data(), var.size(), out);
+        return true;
+    }
+
+    void corrupt ()
+    {
+        amrex::Error("FabCompression::Decompress: corrupt data block");
+    }
+}
+
+std::string
+CodecName (Codec c)
+{
+    switch (c) {
+    case ShuffleLZ: return "lossless";
+    case Lossy:     return "lossy";
+    default:        return "none";
+    }
+}
+
+Codec
+CodecFromName (const std::string& name)
+{
+    if (name == "none") {
+        return None;
+    } else if (name == "lossless") {
+        return ShuffleLZ;
+    } else if (name == "lossy") {
+        return Lossy;
+    } else {
+        amrex::Abort("FabCompression: unknown codec " + name);
+        return None;
+    }
+}
+
+long
+Compress (Codec c, Real tol, const Real* src, long n, Vector<char>& buf)
+{
+    const long start = buf.size();
+    const long rawbytes = n * sizeof(Real);
+
+    if (c == Lossy)
+    {
+        if (tol > 0.0 && compress_lossy(tol, src, n, buf)
+            && static_cast<long>(buf.size())-start < 1+rawbytes)
+        {
+            return buf.size()-start;
+        }
+        buf.resize(start);
+        c = ShuffleLZ;
+    }
+
+    if (c == ShuffleLZ)
+    {
+        // Difference the bit patterns of neighboring values and group the
+        // i-th bytes of all differences together.  For smooth data, the
+        // high-order bytes are then mostly zero.
+        constexpr int nb = sizeof(Real);
+        std::vector<uchar> shuffled(rawbytes);
+        RealBits prev = 0;
+        for (long i = 0; i < n; ++i) {
+            RealBits bits;
+            std::memcpy(&bits, src+i, nb);
+            const RealBits d = bits - prev;
+            prev = bits;
+            const uchar* p = reinterpret_cast<const uchar*>(&d);
+            for (int b = 0; b < nb; ++b) {
+                shuffled[b*n+i] = p[b];
+            }
+        }
+
+        buf.push_back(static_cast<char>(ShuffleLZ));
+        lz_compress(shuffled.data(), rawbytes, buf);
+        if (static_cast<long>(buf.size())-start < 1+rawbytes) {
+            return buf.size()-start;
+        }
+        buf.resize(start);  // it did not compress
+    }
+
+    buf.push_back(static_cast<char>(None));
+    const char* p = reinterpret_cast<const char*>(src);
+    buf.insert(buf.end(), p, p+rawbytes);
+    return buf.size()-start;
+}
+
+void
+Decompress (const char* src, long nbytes, Real* dst, long n)
+{
+    if (nbytes < 1) corrupt();
+
+    const long rawbytes = n * sizeof(Real);
+    const char* p = src+1;
+    const char* end = src+nbytes;
+
+    switch (static_cast<Codec>(src[0]))
+    {
+    case None:
+    {
+        if (end-p != rawbytes) corrupt();
+        std::memcpy(dst, p, rawbytes);
+        break;
+    }
+    case ShuffleLZ:
+    {
+        constexpr int nb = sizeof(Real);
+        std::vector<uchar> shuffled(rawbytes);
+        if (!lz_decompress(reinterpret_cast<const uchar*>(p), end-p,
+                           shuffled.data(), rawbytes)) {
+            corrupt();
+        }
+        RealBits prev = 0;
+        for (long i = 0; i < n; ++i) {
+            RealBits d;
+            uchar* q = reinterpret_cast<uchar*>(&d);
+            for (int b = 0; b < nb; ++b) {
+                q[b] = shuffled[b*n+i];
+            }
+            prev += d;
+            std::memcpy(dst+i, &prev, nb);
+        }
+        break;
+    }
+    case Lossy:
+    {
+        if (end-p < static_cast<long>(2*sizeof(double)+sizeof(int64_t))) corrupt();
+        const double mn   = get_value<double>(p);
+        const double step = get_value<double>(p);
+        const int64_t nvar = get_value<int64_t>(p);
+        if (nvar < n) corrupt();
+        std::vector<uchar> var(nvar);
+        if (!lz_decompress(reinterpret_cast<const uchar*>(p), end-p, var.data(), nvar)) {
+            corrupt();
+        }
+        long iv = 0;
+        int64_t q = 0;
+        for (long i = 0; i < n; ++i) {
+            uint64_t u = 0;
+            int shift = 0;
+            uchar b;
+            do {
+                if (iv >= nvar || shift > 63) corrupt();
+                b = var[iv++];
+                u |= static_cast<uint64_t>(b & 0x7f) << shift;
+                shift += 7;
+            } while (b & 0x80);
+            const int64_t d = static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
+            q += d;
+            dst[i] = static_cast<Real>(mn + static_cast<double>(q) * step);
+        }
+        break;
+    }
+    default:
+        corrupt();
+    }
+}
+
+}}
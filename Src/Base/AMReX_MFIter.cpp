@@ -2,11 +2,40 @@
 #include <AMReX_MFIter.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_FArrayBox.H>
+#include <AMReX_Utility.H>
 
 namespace amrex {
 
 int MFIter::nextDynamicIndex = std::numeric_limits<int>::min();
 
+namespace {
+    const BoxArray* cost_ba = nullptr;
+    const DistributionMapping* cost_dm = nullptr;
+    Vector<Real>* cost_vec = nullptr;
+    int cost_depth = 0;  // number of timed loops this thread is in
+#ifdef _OPENMP
+#pragma omp threadprivate(cost_depth)
+#endif
+}
+
+void
+MFIter::startMeasuringBoxCosts (const BoxArray& ba, const DistributionMapping& dm,
+                                Vector<Real>& costs)
+{
+    AMREX_ALWAYS_ASSERT(costs.size() == ba.size());
+    cost_ba = &ba;
+    cost_dm = &dm;
+    cost_vec = &costs;
+}
+
+void
+MFIter::stopMeasuringBoxCosts ()
+{
+    cost_ba = nullptr;
+    cost_dm = nullptr;
+    cost_vec = nullptr;
+}
+
 MFIter::MFIter (const FabArrayBase& fabarray_, 
 		unsigned char       flags_)
     :
@@ -191,6 +220,11 @@ MFIter::MFIter (const FabArrayBase& fabarray_, const MFItInfo& info)
 
 MFIter::~MFIter ()
 {
+    if (box_costs) {
+        if (isValid()) addBoxCost();
+        --cost_depth;
+    }
+
 #ifdef BL_USE_TEAM
     if ( ! (flags & NoTeamBarrier) )
 	ParallelDescriptor::MyTeam().MemoryBarrier();
@@ -314,6 +348,30 @@ MFIter::Initialize ()
 
 	typ = fabArray.boxArray().ixType();
     }
+
+    if (cost_vec && cost_depth == 0 && currentIndex < endIndex &&
+        BoxArray::SameRefs(fabArray.boxArray(), *cost_ba) &&
+        DistributionMapping::SameRefs(fabArray.DistributionMap(), *cost_dm))
+    {
+        box_costs = cost_vec;
+        ++cost_depth;
+        box_start_time = amrex::second();
+    }
+}
+
+void
+MFIter::addBoxCost () noexcept
+{
+#ifdef AMREX_USE_GPU
+    Gpu::synchronize();
+#endif
+    const double t = amrex::second();
+    Real& c = (*box_costs)[index()];
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    c += t - box_start_time;
+    box_start_time = t;
 }
 
 Box 
@@ -465,6 +523,8 @@ MFIter::grownnodaltilebox (int dir, IntVect const& a_ng) const noexcept
 void
 MFIter::operator++ () noexcept
 {
+    if (box_costs) addBoxCost();
+
 #ifdef _OPENMP
     if (dynamic)
     {
@@ -706,4 +766,136 @@ MFGhostIter::Initialize ()
     tile_array      = &(lta.tileArray);
 }
 
+MFOverlapIter::MFOverlapIter (const FabArrayBase& fabarray, const IntVect& nghost,
+                              const MFItInfo& info, std::function<void()> finish)
+    :
+    MFIter(fabarray, (unsigned char)(SkipInit | (info.do_tiling ? Tiling : 0))),
+    m_finish(std::move(finish))
+{
+    tile_size = info.do_tiling ? info.tilesize : IntVect::TheZeroVector();
+    streams = info.num_streams;
+    device_sync = info.device_sync;
+    Initialize(nghost);
+}
+
+void
+MFOverlapIter::Initialize (const IntVect& nghost)
+{
+    BL_PROFILE("MFOverlapIter::Initialize()");
+
+    typ = fabArray.boxArray().ixType();
+
+    const BoxArray& ba = fabArray.boxArray();
+    const Vector<int>& idxarr = fabArray.IndexArray();
+    const int nlocal = idxarr.size();
+    const bool tiling = tile_size != IntVect::TheZeroVector();
+
+    // Tiles are cell-centered like those in FabArrayBase::TileArray.
+    // Interior tiles of all boxes go first, followed by boundary shells.
+    Vector<int> ntiles(nlocal, 0);
+    Vector<int> bnd_index, bnd_local_index, bnd_local_tile;
+    Vector<Box> bnd_tiles;
+
+    for (int i = 0; i < nlocal; ++i)
+    {
+        const int K = idxarr[i];
+        const Box& vbx = ba.getCellCenteredBox(K);
+        const Box& ibx = amrex::grow(vbx, -nghost);
+
+        if (ibx.ok())
+        {
+            BoxList tiles = tiling ? BoxList(ibx, tile_size) : BoxList(ibx);
+            for (const Box& t : tiles) {
+                m_ta.indexMap.push_back(K);
+                m_ta.localIndexMap.push_back(i);
+                m_ta.localTileIndexMap.push_back(ntiles[i]++);
+                m_ta.tileArray.push_back(t);
+            }
+        }
+
+        const BoxList& shells = ibx.ok() ? amrex::boxDiff(vbx, ibx) : BoxList(vbx);
+        for (const Box& sbx : shells)
+        {
+            BoxList tiles = tiling ? BoxList(sbx, tile_size) : BoxList(sbx);
+            for (const Box& t : tiles) {
+                bnd_index.push_back(K);
+                bnd_local_index.push_back(i);
+                bnd_local_tile.push_back(ntiles[i]++);
+                bnd_tiles.push_back(t);
+            }
+        }
+    }
+
+    const int nint = m_ta.indexMap.size();
+    const int ntot = nint + bnd_index.size();
+
+    m_ta.indexMap.insert(m_ta.indexMap.end(), bnd_index.begin(), bnd_index.end());
+    m_ta.localIndexMap.insert(m_ta.localIndexMap.end(),
+                              bnd_local_index.begin(), bnd_local_index.end());
+    m_ta.localTileIndexMap.insert(m_ta.localTileIndexMap.end(),
+                                  bnd_local_tile.begin(), bnd_local_tile.end());
+    m_ta.tileArray.insert(m_ta.tileArray.end(), bnd_tiles.begin(), bnd_tiles.end());
+
+    m_ta.numLocalTiles.resize(ntot);
+    for (int it = 0; it < ntot; ++it) {
+        m_ta.numLocalTiles[it] = ntiles[m_ta.localIndexMap[it]];
+    }
+
+    m_ta.nuse = 0;
+    index_map            = &(m_ta.indexMap);
+    local_index_map      = &(m_ta.localIndexMap);
+    tile_array           = &(m_ta.tileArray);
+    local_tile_index_map = &(m_ta.localTileIndexMap);
+    num_local_tiles      = &(m_ta.numLocalTiles);
+
+    // Static split of each phase among threads.
+    int tid = 0;
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_num_threads();
+    if (nthreads > 1) tid = omp_get_thread_num();
+#endif
+
+    auto split = [tid, nthreads] (int b, int e, int& tb, int& te)
+    {
+        int n    = e - b;
+        int nr   = n / nthreads;
+        int nlft = n - nr * nthreads;
+        if (tid < nlft) {
+            tb = b + tid * (nr + 1);
+            te = tb + nr + 1;
+        } else {
+            tb = b + tid * nr + nlft;
+            te = tb + nr;
+        }
+    };
+
+    split(0, nint, beginIndex, endIndex);
+    split(nint, ntot, m_bnd_begin, m_bnd_end);
+    currentIndex = beginIndex;
+}
+
+void
+MFOverlapIter::finishInterior ()
+{
+    BL_ASSERT(!m_finished);
+
+#ifdef _OPENMP
+    if (omp_in_parallel())
+    {
+#pragma omp barrier
+#pragma omp single
+        m_finish();
+    }
+    else
+#endif
+    {
+        m_finish();
+    }
+
+    m_finished = true;
+    currentIndex = m_bnd_begin;
+    endIndex     = m_bnd_end;
+}
+
 }
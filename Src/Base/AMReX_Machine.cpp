@@ -211,6 +211,13 @@ class Machine
         get_params();
         get_machine_envs();
         node_ids = get_node_ids();
+        shared_node_ids = get_shared_node_ids();
+    }
+
+    // get all node IDs in this job, indexed by job rank.  Off the machines
+    // whose topology we know, the nodes are the shared memory domains.
+    const Vector<int>& all_node_ids () const {
+        return flag_nersc_df ? node_ids : shared_node_ids;
     }
 
     // find a compact neighborhood of size rank_n in the current ParallelContext subgroup
@@ -320,6 +327,7 @@ class Machine
     bool flag_nersc_df;
     int my_node_id;
     Vector<int> node_ids;
+    Vector<int> shared_node_ids;
 
     NeighborhoodCache nbh_cache;
 
@@ -429,6 +437,28 @@ class Machine
         return ids;
     }
 
+    // get the shared memory domain of every rank in this job, indexed by
+    // job rank, as the lowest job rank in it.
+    // this is collective over ALL ranks in the job
+    Vector<int> get_shared_node_ids ()
+    {
+        Vector<int> ids(ParallelDescriptor::NProcs(), 0);
+#ifdef BL_USE_MPI
+        MPI_Comm comm_all = ParallelContext::CommunicatorAll();
+        int rank_me;
+        MPI_Comm_rank(comm_all, &rank_me);
+
+        MPI_Comm shared_comm;
+        MPI_Comm_split_type(comm_all, MPI_COMM_TYPE_SHARED, rank_me, MPI_INFO_NULL, &shared_comm);
+        int node_id;
+        MPI_Allreduce(&rank_me, &node_id, 1, MPI_INT, MPI_MIN, shared_comm);
+        MPI_Comm_free(&shared_comm);
+
+        ParallelAllGather::AllGather(node_id, ids.data(), comm_all);
+#endif
+        return ids;
+    }
+
     // do a local search starting at current node
     std::pair<Vector<int>, double>
     baseline_score(const Vector<int> & sg_node_ids, int nbh_rank_n)
@@ -588,4 +618,9 @@ Vector<int> find_best_nbh (int rank_n, bool flag_local_ranks) {
     return the_machine->find_best_nbh(rank_n, flag_local_ranks);
 }
 
+const Vector<int>& node_ids () {
+    AMREX_ASSERT(the_machine);
+    return the_machine->all_node_ids();
+}
+
 }}
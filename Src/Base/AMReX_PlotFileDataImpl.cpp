@@ -1,7 +1,12 @@
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <AMReX_PlotFileDataImpl.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_VisMF.H>
+#include <AMReX_FPC.H>
+#include <AMReX_Utility.H>
 
 namespace amrex {
 
@@ -96,8 +101,6 @@ PlotFileDataImpl::PlotFileDataImpl (std::string const& plotfile_name)
     }
 }
 
-PlotFileDataImpl::~PlotFileDataImpl () {}
-
 void
 PlotFileDataImpl::syncDistributionMap (PlotFileDataImpl const& src) noexcept
 {
@@ -127,19 +130,102 @@ MultiFab
 PlotFileDataImpl::get (int level, std::string const& varname) noexcept
 {
     MultiFab mf(m_ba[level], m_dmap[level], 1, m_ngrow[level]);
-    auto r = std::find(std::begin(m_var_names), std::end(m_var_names), varname);
-    if (r == std::end(m_var_names)) {
-        amrex::Abort("PlotFileDataImpl::get: varname not found "+varname);
+    const int icomp = compIndex(varname);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        int gid = mfi.index();
+        FArrayBox& dstfab = mf[mfi];
+        std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, icomp));
+        dstfab.copy(*srcfab);
+    }
+    return mf;
+}
+
+FArrayBox
+PlotFileDataImpl::getFab (int level, int gid, std::string const& varname) noexcept
+{
+    const int icomp = compIndex(varname);
+    const Box fab_box = amrex::grow(m_ba[level][gid], m_ngrow[level]);
+    const long npts = fab_box.numPts();
+
+    RealDescriptor rd;
+    char* p = m_vismf[level]->mapFabData(gid, rd);
+    if (p == nullptr) {
+        std::unique_ptr<FArrayBox> fab(m_vismf[level]->readFAB(gid, icomp));
+        return std::move(*fab);
+    }
+
+    p += npts * icomp * rd.numBytes();
+    const bool native = (rd == FPC::NativeRealDescriptor());
+    if (native && reinterpret_cast<std::uintptr_t>(p) % alignof(Real) == 0) {
+        // Alias the mapped file.  Pages are read from disk when they are touched.
+        return FArrayBox(fab_box, 1, reinterpret_cast<Real const*>(p));
     } else {
-        int icomp = std::distance(std::begin(m_var_names), r);
-        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-            int gid = mfi.index();
-            FArrayBox& dstfab = mf[mfi];
-            std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, icomp));
-            dstfab.copy(*srcfab);
+        FArrayBox fab(fab_box, 1);
+        if (native) {
+            std::memcpy(fab.dataPtr(), p, npts*sizeof(Real));
+        } else {
+            RealDescriptor::convertToNativeFormat(fab.dataPtr(), npts, p, rd);
         }
+        return fab;
     }
-    return mf;
+}
+
+Real
+PlotFileDataImpl::min (int level, std::string const& varname) noexcept
+{
+    const int icomp = compIndex(varname);
+    const VisMF::Header& hdr = m_vismf[level]->header();
+    Real r = std::numeric_limits<Real>::max();
+    if (!hdr.m_min.empty()) {
+        for (auto const& fabmin : hdr.m_min) {
+            r = std::min(r, fabmin[icomp]);
+        }
+    } else if (!hdr.m_famin.empty()) {
+        r = hdr.m_famin[icomp];
+    } else {
+        const int myproc = ParallelDescriptor::MyProc();
+        for (int gid = 0, N = m_ba[level].size(); gid < N; ++gid) {
+            if (m_dmap[level][gid] == myproc) {
+                r = std::min(r, getFab(level, gid, varname).min(m_ba[level][gid], 0));
+            }
+        }
+        ParallelDescriptor::ReduceRealMin(r);
+    }
+    return r;
+}
+
+Real
+PlotFileDataImpl::max (int level, std::string const& varname) noexcept
+{
+    const int icomp = compIndex(varname);
+    const VisMF::Header& hdr = m_vismf[level]->header();
+    Real r = std::numeric_limits<Real>::lowest();
+    if (!hdr.m_max.empty()) {
+        for (auto const& fabmax : hdr.m_max) {
+            r = std::max(r, fabmax[icomp]);
+        }
+    } else if (!hdr.m_famax.empty()) {
+        r = hdr.m_famax[icomp];
+    } else {
+        const int myproc = ParallelDescriptor::MyProc();
+        for (int gid = 0, N = m_ba[level].size(); gid < N; ++gid) {
+            if (m_dmap[level][gid] == myproc) {
+                r = std::max(r, getFab(level, gid, varname).max(m_ba[level][gid], 0));
+            }
+        }
+        ParallelDescriptor::ReduceRealMax(r);
+    }
+    return r;
+}
+
+int
+PlotFileDataImpl::compIndex (std::string const& varname) const noexcept
+{
+    auto r = std::find(std::begin(m_var_names), std::end(m_var_names), varname);
+    if (r == std::end(m_var_names)) {
+        amrex::Abort("PlotFileDataImpl: varname not found "+varname);
+    }
+    return std::distance(std::begin(m_var_names), r);
 }
 
 }
@@ -4,6 +4,7 @@
 
 #include <AMReX_VisMF.H>
 #include <AMReX_PlotFileUtil.H>
+#include <AMReX_AsyncOut.H>
 
 #ifdef AMREX_USE_EB
 #include <AMReX_EBFabFactory.H>
@@ -222,7 +223,11 @@ WriteMultiLevelPlotfile (const std::string& plotfilename, int nlevels,
         } else {
             data = mf[level];
         }
-	VisMF::Write(*data, MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix));
+        if (AsyncOut::UseAsyncOut()) {
+            VisMF::WriteAsyncOut(*data, MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix));
+        } else {
+            VisMF::Write(*data, MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix));
+        }
     }
 
 //    VisMF::SetNOutFiles(saveNFiles);
@@ -0,0 +1,185 @@
+
+#include <AMReX_TArena.H>
+#include <AMReX_BLassert.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace amrex {
+
+namespace {
+    // floor(log2(n)) for n > 0
+    int ilog2 (std::size_t n) noexcept
+    {
+        int r = 0;
+        while (n >>= 1) ++r;
+        return r;
+    }
+}
+
+constexpr std::size_t TArena::DefaultMaxBlockSize;
+constexpr std::size_t TArena::DefaultCacheSize;
+
+TArena::TArena (std::size_t max_block_size, std::size_t cache_size, ArenaInfo info)
+    :
+    m_max_block_size(max_block_size > 0 ? max_block_size : DefaultMaxBlockSize),
+    m_cache_size(cache_size > 0 ? cache_size : DefaultCacheSize)
+{
+    static_assert(sizeof(Header) % align_size == 0,
+                  "TArena: Header size must be a multiple of align_size");
+
+    arena_info = info;
+
+    m_nclasses = size_class(Arena::align(m_max_block_size) + sizeof(Header)) + 1;
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    m_caches.resize(nthreads);
+    for (auto& c : m_caches) {
+        c.reset(new Cache);
+        c->bins.resize(m_nclasses);
+    }
+}
+
+TArena::~TArena ()
+{
+    for (auto& c : m_caches) {
+        for (auto& bin : c->bins) {
+            for (Header* h : bin) {
+                deallocate_system(h, h->nbytes);
+            }
+        }
+    }
+}
+
+int
+TArena::size_class (std::size_t nbytes) const noexcept
+{
+    // Class 0 is 64 bytes.  Above that there are four classes per power
+    // of two: 2^p + k*2^(p-2), k = 1, 2, 3, 4.
+    if (nbytes <= 64) return 0;
+    const int p = ilog2(nbytes-1);
+    const std::size_t base = std::size_t(1) << p;
+    const std::size_t step = base >> 2;
+    const int k = static_cast<int>((nbytes - base + step - 1) / step);
+    return 1 + (p-6)*4 + (k-1);
+}
+
+std::size_t
+TArena::class_size (int cls) const noexcept
+{
+    if (cls == 0) return 64;
+    const int p = 6 + (cls-1)/4;
+    const int k = (cls-1)%4 + 1;
+    return (std::size_t(1) << p) + k * (std::size_t(1) << (p-2));
+}
+
+TArena::Cache&
+TArena::my_cache (int& tid) noexcept
+{
+    tid = 0;
+#ifdef _OPENMP
+    tid = omp_get_thread_num();
+#endif
+    // Nested regions or threads started outside OpenMP may share a cache.
+    // That is still safe because of the lock, just slower.
+    const int ncaches = m_caches.size();
+    if (tid >= ncaches) tid %= ncaches;
+    return *m_caches[tid];
+}
+
+void*
+TArena::alloc (std::size_t nbytes)
+{
+    std::size_t n = Arena::align(nbytes) + sizeof(Header);
+    int cls = size_class(n);
+    if (cls >= m_nclasses) {
+        cls = -1;
+    } else {
+        n = class_size(cls);
+    }
+
+    int tid;
+    Cache& c = my_cache(tid);
+    std::lock_guard<std::mutex> lock(c.mutex);
+
+    if (cls >= 0)
+    {
+        auto& bin = c.bins[cls];
+        if (!bin.empty()) {
+            Header* h = bin.back();
+            bin.pop_back();
+            c.cached_bytes -= h->nbytes;
+            ++c.hits;
+            return static_cast<void*>(h+1);
+        }
+    }
+
+    ++c.misses;
+    Header* h = static_cast<Header*>(allocate_system(n));
+    h->nbytes = n;
+    h->cls = cls;
+    h->owner = tid;
+    c.system_bytes += n;
+    return static_cast<void*>(h+1);
+}
+
+void
+TArena::free (void* vp)
+{
+    if (vp == nullptr) return;
+
+    Header* h = static_cast<Header*>(vp) - 1;
+
+    int tid;
+    Cache& c = my_cache(tid);
+    std::lock_guard<std::mutex> lock(c.mutex);
+
+    if (h->owner != tid) {
+        // The block migrates to this thread's cache.
+        ++c.cross_thread_frees;
+        h->owner = tid;
+    }
+
+    if (h->cls >= 0 && c.cached_bytes + h->nbytes <= m_cache_size)
+    {
+        c.bins[h->cls].push_back(h);
+        c.cached_bytes += h->nbytes;
+    }
+    else
+    {
+        c.system_bytes -= h->nbytes;
+        deallocate_system(h, h->nbytes);
+    }
+}
+
+ArenaCounters
+TArena::counters () const
+{
+    ArenaCounters r;
+    for (auto const& c : m_caches) {
+        std::lock_guard<std::mutex> lock(c->mutex);
+        r.hits               += c->hits;
+        r.misses             += c->misses;
+        r.cross_thread_frees += c->cross_thread_frees;
+    }
+    return r;
+}
+
+std::size_t
+TArena::heap_space_used () const noexcept
+{
+    // Blocks may be freed by a thread other than the one that allocated
+    // them, so the per-thread numbers are only meaningful as a sum.
+    long r = 0;
+    for (auto const& c : m_caches) {
+        std::lock_guard<std::mutex> lock(c->mutex);
+        r += c->system_bytes;
+    }
+    return static_cast<std::size_t>(r);
+}
+
+}
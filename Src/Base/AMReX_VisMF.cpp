@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -17,6 +19,12 @@
 #include <AMReX_NFiles.H>
 #include <AMReX_FPC.H>
 #include <AMReX_FabArrayUtility.H>
+#include <AMReX_AsyncOut.H>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace amrex {
 
@@ -37,6 +45,8 @@ bool VisMF::usePersistentIFStreams(false);
 bool VisMF::useSynchronousReads(false);
 bool VisMF::useDynamicSetSelection(true);
 bool VisMF::allowSparseWrites(true);
+FabCompression::Codec VisMF::compressionCodec(FabCompression::ShuffleLZ);
+Real VisMF::compressionTol(0.0);
 
 long VisMF::ioBufferSize(VisMF::IO_Buffer_Size);
 
@@ -87,6 +97,14 @@ VisMF::Initialize ()
     pp.query("iobuffersize", ioBufferSize);
     pp.query("allowsparsewrites", allowSparseWrites);
 
+    std::string codec(FabCompression::CodecName(compressionCodec));
+    pp.query("compression", codec);
+    compressionCodec = FabCompression::CodecFromName(codec);
+    pp.query("compression_tol", compressionTol);
+    if(compressionCodec == FabCompression::Lossy && compressionTol <= 0.0) {
+      amrex::Abort("VisMF::Initialize:  vismf.compression = lossy requires vismf.compression_tol > 0");
+    }
+
     initialized = true;
 }
 
@@ -284,12 +302,30 @@ operator<< (std::ostream        &os,
     os << hd.m_fod      << '\n';
 
     if(hd.m_vers == VisMF::Header::Version_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1)
     {
       os << hd.m_min      << '\n';
       os << hd.m_max      << '\n';
     }
 
+    if(hd.m_vers == VisMF::Header::Compressed_v1) {
+      BL_ASSERT(hd.m_codec.size() == hd.m_ncomp);
+      BL_ASSERT(hd.m_ctol.size() == hd.m_ncomp);
+      for(int i(0); i < hd.m_codec.size(); ++i) {
+        os << hd.m_codec[i] << ' ' << hd.m_ctol[i] << ',';
+      }
+      os << '\n';
+      BL_ASSERT(hd.m_csize.size() == hd.m_ba.size());
+      for(int i(0); i < hd.m_csize.size(); ++i) {
+        for(int j(0); j < hd.m_csize[i].size(); ++j) {
+          os << hd.m_csize[i][j] << ' ';
+        }
+        os << '\n';
+      }
+      os << FPC::NativeRealDescriptor() << '\n';
+    }
+
     if(hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1) {
       BL_ASSERT(hd.m_famin.size() == hd.m_ncomp);
       BL_ASSERT(hd.m_famin.size() == hd.m_famax.size());
@@ -368,7 +404,8 @@ operator>> (std::istream  &is,
     BL_ASSERT(hd.m_ba.size() == hd.m_fod.size());
 
     if(hd.m_vers == VisMF::Header::Version_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1)
     {
       is >> hd.m_min;
       is >> hd.m_max;
@@ -376,6 +413,26 @@ operator>> (std::istream  &is,
       BL_ASSERT(hd.m_ba.size() == hd.m_max.size());
     }
 
+    if(hd.m_vers == VisMF::Header::Compressed_v1) {
+      char ch;
+      hd.m_codec.resize(hd.m_ncomp);
+      hd.m_ctol.resize(hd.m_ncomp);
+      for(int i(0); i < hd.m_codec.size(); ++i) {
+        is >> hd.m_codec[i] >> hd.m_ctol[i] >> ch;
+	if( ch != ',' ) {
+	  amrex::Error("Expected a ',' when reading hd.m_codec");
+	}
+      }
+      hd.m_csize.resize(hd.m_ba.size());
+      for(int i(0); i < hd.m_csize.size(); ++i) {
+        hd.m_csize[i].resize(hd.m_ncomp);
+        for(int j(0); j < hd.m_ncomp; ++j) {
+          is >> hd.m_csize[i][j];
+        }
+      }
+      is >> hd.m_writtenRD;
+    }
+
     if(hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1) {
       char ch;
       hd.m_famin.resize(hd.m_ncomp);
@@ -922,6 +979,13 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
     BL_ASSERT(mf_name[mf_name.length() - 1] != '/');
     BL_ASSERT(currentVersion != VisMF::Header::Undefined_v1);
 
+    if(currentVersion == VisMF::Header::Compressed_v1) {
+      if(set_ghost) {
+        SetGhostToMidRange(mf);
+      }
+      return VisMF::WriteCompressed(mf, mf_name, how);
+    }
+
     // ---- add stream retry
     // ---- add stream buffer (to nfiles)
     RealDescriptor *whichRD = nullptr;
@@ -937,19 +1001,7 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
     bool doConvert(*whichRD != FPC::NativeRealDescriptor());
 
     if(set_ghost) {
-        FabArray<FArrayBox>* the_mf = const_cast<FabArray<FArrayBox>*>(&mf);
-
-        for(MFIter mfi(*the_mf); mfi.isValid(); ++mfi) {
-            const int idx(mfi.index());
-
-            for(int j(0); j < mf.nComp(); ++j) {
-                const Real valMin(mf[mfi].min(mf.box(idx), j));
-                const Real valMax(mf[mfi].max(mf.box(idx), j));
-                const Real val((valMin + valMax) / 2.0);
-
-                the_mf->get(mfi).setComplement(val, mf.box(idx), j, 1);
-            }
-        }
+        SetGhostToMidRange(mf);
     }
 
     // ---- check if mf has sparse data
@@ -1090,6 +1142,78 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
 }
 
 
+long
+VisMF::WriteCompressed (const FabArray<FArrayBox>& mf,
+                        const std::string&         mf_name,
+                        VisMF::How                 how)
+{
+    BL_PROFILE("VisMF::WriteCompressed()");
+
+    const int nComp(mf.nComp());
+    const int nFabs(mf.size());
+    const int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
+
+    bool calcMinMax(false);
+    VisMF::Header hdr(mf, how, VisMF::Header::Compressed_v1, calcMinMax);
+    hdr.m_codec.assign(nComp, compressionCodec);
+    hdr.m_ctol.assign(nComp, compressionTol);
+
+    // ---- compress each component of each local fab into one buffer
+    Vector<char> cData;
+    Vector<long> localOffset(nFabs, 0);
+    Vector<long> cSize(nFabs * nComp, 0);    // ---- [findex*nComp + comp]
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+      const int idx(mfi.index());
+      const FArrayBox &fab = mf[mfi];
+      const long nPts(fab.box().numPts());
+      localOffset[idx] = cData.size();
+      for(int comp(0); comp < nComp; ++comp) {
+        cSize[idx*nComp + comp] = FabCompression::Compress(compressionCodec, compressionTol,
+                                                           fab.dataPtr(comp), nPts, cData);
+      }
+    }
+
+    // ---- the file layout is not known in advance, so use static sets
+    std::string filePrefix(mf_name + FabFileSuffix);
+    Vector<long> fabHead(nFabs, 0);
+
+    NFilesIter nfi(nOutFiles, filePrefix, groupSets, setBuf);
+    for( ; nfi.ReadyToWrite(); ++nfi) {
+      const long baseOffset(VisMF::FileOffset(nfi.Stream()));
+      for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        fabHead[mfi.index()] = baseOffset + localOffset[mfi.index()];
+      }
+      nfi.Stream().write(cData.dataPtr(), cData.size());
+      nfi.Stream().flush();
+    }
+
+    long bytesWritten(cData.size());
+
+    hdr.CalculateMinMax(mf, coordinatorProc);
+
+    ParallelDescriptor::ReduceLongSum(fabHead.dataPtr(), fabHead.size(), coordinatorProc);
+    ParallelDescriptor::ReduceLongSum(cSize.dataPtr(), cSize.size(), coordinatorProc);
+
+    if(ParallelDescriptor::MyProc() == coordinatorProc) {
+      const Vector<int> &pmap = mf.DistributionMap().ProcessorMap();
+      hdr.m_csize.resize(nFabs);
+      for(int i(0); i < nFabs; ++i) {
+        const std::string name(NFilesIter::FileName(nOutFiles, filePrefix, pmap[i], groupSets));
+        hdr.m_fod[i].m_name = VisMF::BaseName(name);
+        hdr.m_fod[i].m_head = fabHead[i];
+        hdr.m_csize[i].resize(nComp);
+        for(int comp(0); comp < nComp; ++comp) {
+          hdr.m_csize[i][comp] = cSize[i*nComp + comp];
+        }
+      }
+    }
+
+    bytesWritten += VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
+
+    return bytesWritten;
+}
+
+
 long
 VisMF::WriteOnlyHeader (const FabArray<FArrayBox> & mf,
                         const std::string         & mf_name,
@@ -1352,6 +1476,75 @@ VisMF::VisMF (const std::string &fafab_name)
 
 VisMF::~VisMF ()
 {
+    for (auto const& kv : m_mapped_files) {
+        if (kv.second.data) {
+            ::munmap(kv.second.data, kv.second.nbytes);
+        }
+    }
+}
+
+char*
+VisMF::mapFabData (int fabIndex, RealDescriptor& rd) noexcept
+{
+    if (m_hdr.m_vers == VisMF::Header::Compressed_v1) {
+        return nullptr;
+    }
+
+    const std::string fname = VisMF::DirName(m_fafabname) + m_hdr.m_fod[fabIndex].m_name;
+
+    auto it = m_mapped_files.find(fname);
+    if (it == m_mapped_files.end()) {
+        MappedFile mfile;
+        int fd = ::open(fname.c_str(), O_RDONLY);
+        if (fd < 0) {
+            amrex::FileOpenFailed(fname);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            // A private writable mapping, because the format conversion
+            // routines take non-const input.  The file is never modified.
+            void* p = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                mfile.data = static_cast<char*>(p);
+                mfile.nbytes = st.st_size;
+            }
+        }
+        ::close(fd);
+        it = m_mapped_files.emplace(fname, mfile).first;
+    }
+
+    char* const data = it->second.data;
+    const std::size_t nbytes = it->second.nbytes;
+    std::size_t pos = m_hdr.m_fod[fabIndex].m_head;
+    if (data == nullptr || pos >= nbytes) {
+        return nullptr;
+    }
+
+    if (m_hdr.m_vers == VisMF::Header::Version_v1) {
+        // The FAB header is a single line, e.g., "FAB ((8, (...)),(8, (...)))((0,0,0) (7,7,7) (0,0,0)) 2"
+        const std::size_t maxlen = std::min(nbytes-pos, std::size_t(1024));
+        const char* eol = static_cast<const char*>(std::memchr(data+pos, '\n', maxlen));
+        if (eol == nullptr) {
+            return nullptr;
+        }
+        std::istringstream is(std::string(data+pos, eol-(data+pos)));
+        char c[3];
+        is >> c[0] >> c[1] >> c[2] >> std::ws;
+        if (c[0] != 'F' || c[1] != 'A' || c[2] != 'B' || is.peek() == ':') {
+            return nullptr;  // The old FAB format is not supported here.
+        }
+        is >> rd;
+        pos = eol + 1 - data;
+    } else {
+        rd = m_hdr.m_writtenRD;
+    }
+
+    const Box fab_box = amrex::grow(m_hdr.m_ba[fabIndex], m_hdr.m_ngrow);
+    if (pos + fab_box.numPts() * m_hdr.m_ncomp * rd.numBytes() > nbytes) {
+        return nullptr;
+    }
+
+    return data + pos;
 }
 
 
@@ -1375,7 +1568,24 @@ VisMF::readFAB (int                  idx,
     std::ifstream *infs = VisMF::OpenStream(FullName);
     infs->seekg(hdr.m_fod[idx].m_head, std::ios::beg);
 
-    if(hdr.m_vers == Header::Version_v1) {
+    if(hdr.m_vers == Header::Compressed_v1) {
+      const long nPts(fab->box().numPts());
+      int compBegin(0), compEnd(hdr.m_ncomp);
+      if(whichComp != -1) {
+        for(int comp(0); comp < whichComp; ++comp) {
+          infs->seekg(hdr.m_csize[idx][comp], std::ios::cur);
+        }
+        compBegin = whichComp;
+        compEnd   = whichComp + 1;
+      }
+      Vector<char> cData;
+      for(int comp(compBegin); comp < compEnd; ++comp) {
+        cData.resize(hdr.m_csize[idx][comp]);
+        infs->read(cData.dataPtr(), cData.size());
+        FabCompression::Decompress(cData.dataPtr(), cData.size(),
+                                   fab->dataPtr(comp - compBegin), nPts);
+      }
+    } else if(hdr.m_vers == Header::Version_v1) {
       if(whichComp == -1) {    // ---- read all components
         fab->readFrom(*infs);
       } else {
@@ -1425,7 +1635,21 @@ VisMF::readFAB (FabArray<FArrayBox> &mf,
     std::ifstream *infs = VisMF::OpenStream(FullName);
     infs->seekg(hdr.m_fod[idx].m_head, std::ios::beg);
 
-    if(NoFabHeader(hdr)) {
+    if(hdr.m_vers == Header::Compressed_v1) {
+      const long nPts(fab.box().numPts());
+      long totalBytes(0);
+      for(int comp(0); comp < hdr.m_ncomp; ++comp) {
+        totalBytes += hdr.m_csize[idx][comp];
+      }
+      Vector<char> cData(totalBytes);
+      infs->read(cData.dataPtr(), totalBytes);
+      long pos(0);
+      for(int comp(0); comp < hdr.m_ncomp; ++comp) {
+        FabCompression::Decompress(cData.dataPtr() + pos, hdr.m_csize[idx][comp],
+                                   fab.dataPtr(comp), nPts);
+        pos += hdr.m_csize[idx][comp];
+      }
+    } else if(NoFabHeader(hdr)) {
       if(hdr.m_writtenRD == FPC::NativeRealDescriptor()) {
         infs->read((char *) fab.dataPtr(), fab.nBytes());
       } else {
@@ -1441,6 +1665,37 @@ VisMF::readFAB (FabArray<FArrayBox> &mf,
 }
 
 
+void
+VisMF::ReadMapped (FabArray<FArrayBox> &mf, const std::string &mf_name)
+{
+    BL_PROFILE("VisMF::ReadMapped()");
+
+    VisMF vismf(mf_name);
+    const Header& hdr = vismf.header();
+    AMREX_ASSERT(hdr.m_ncomp == mf.nComp() && hdr.m_ngrow == mf.nGrowVect());
+    AMREX_ASSERT(hdr.m_ba == mf.boxArray());
+
+    bool mapped = true;
+    for (MFIter mfi(mf); mfi.isValid() && mapped; ++mfi)
+    {
+        FArrayBox& fab = mf[mfi];
+        RealDescriptor rd;
+        char* p = vismf.mapFabData(mfi.index(), rd);
+        if (p == nullptr) {
+            mapped = false;
+        } else if (rd == FPC::NativeRealDescriptor()) {
+            std::memcpy(fab.dataPtr(), p, fab.size()*sizeof(Real));
+        } else {
+            RealDescriptor::convertToNativeFormat(fab.dataPtr(), fab.size(), p, rd);
+        }
+    }
+
+    ParallelDescriptor::ReduceBoolAnd(mapped);
+    if (!mapped) {
+        VisMF::Read(mf, mf_name);
+    }
+}
+
 void
 VisMF::Read (FabArray<FArrayBox> &mf,
              const std::string   &mf_name,
@@ -2132,20 +2387,77 @@ void VisMF::CloseAllStreams() {
   VisMF::persistentIFStreams.clear();
 }
 
+void
+VisMF::SetGhostToMidRange (const FabArray<FArrayBox>& mf)
+{
+    FabArray<FArrayBox>* the_mf = const_cast<FabArray<FArrayBox>*>(&mf);
+
+    for(MFIter mfi(*the_mf); mfi.isValid(); ++mfi) {
+        const int idx(mfi.index());
+
+        for(int j(0); j < mf.nComp(); ++j) {
+            const Real valMin(mf[mfi].min(mf.box(idx), j));
+            const Real valMax(mf[mfi].max(mf.box(idx), j));
+            const Real val((valMin + valMax) / 2.0);
+
+            the_mf->get(mfi).setComplement(val, mf.box(idx), j, 1);
+        }
+    }
+}
+
 std::future<WriteAsyncStatus>
-VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
+VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name,
+                   VisMF::How how)
 {
     BL_PROFILE("VisMF::WriteAysnc()");
-    AMREX_ASSERT(mf_name[mf_name.length() - 1] != '/');
+    return std::async(std::launch::async, PrepareWriteAsync(mf, mf_name, how));
+}
 
-    const int nfiles = nOutFiles;
-    // const int nfiles = 2; // for testing only
+long
+VisMF::WriteAsyncOut (const FabArray<FArrayBox>& mf, const std::string& mf_name,
+                      VisMF::How how, bool set_ghost)
+{
+    BL_PROFILE("VisMF::WriteAsyncOut()");
+
+    if (set_ghost) {
+        SetGhostToMidRange(mf);
+    }
+
+    std::function<WriteAsyncStatus()> f = PrepareWriteAsync(mf, mf_name, how);
+    const int v = verbose;
+    return AsyncOut::Submit([f,v] () {
+        WriteAsyncStatus status = f();
+        if (!status.ok) {
+            AsyncOut::ReportError();
+        }
+        if (v > 1) {
+            AllPrint() << "VisMF::WriteAsyncOut: " << status << "\n";
+        }
+    });
+}
+
+std::function<WriteAsyncStatus()>
+VisMF::PrepareWriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name,
+                          VisMF::How how)
+{
+    BL_PROFILE("VisMF::PrepareWriteAsync()");
+    AMREX_ASSERT(mf_name[mf_name.length() - 1] != '/');
+    AMREX_ASSERT(currentVersion != VisMF::Header::Undefined_v1);
 
     const DistributionMapping& dm = mf.DistributionMap();
 
     int myproc = ParallelDescriptor::MyProc();
     int nprocs = ParallelDescriptor::NProcs();
 
+    const int nfiles = (how == OneFilePerCPU) ? nprocs : nOutFiles;
+    // const int nfiles = 2; // for testing only
+
+    // ---- the version is taken now, so that the settings of the caller
+    // ---- (e.g., Amr's plot and checkpoint header versions) are used
+    const VisMF::Header::Version version = currentVersion;
+    const bool fabHeader  = (version == VisMF::Header::Version_v1);
+    const bool compressed = (version == VisMF::Header::Compressed_v1);
+
     RealDescriptor const& whichRD = []() -> RealDescriptor const& {
         switch (FArrayBox::getFormat())
         {
@@ -2159,9 +2471,15 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
             return FPC::NativeRealDescriptor();
         }
     }();
-    bool doConvert = whichRD != FPC::NativeRealDescriptor();
+    // ---- compressed data are always in the native format
+    bool doConvert = !compressed && whichRD != FPC::NativeRealDescriptor();
 
-    VisMF::Header hdr(mf, VisMF::NFiles, VisMF::Header::Version_v1, true);
+    // ---- min and max are computed below and filled in by the I/O task
+    VisMF::Header hdr(mf, how, version, false);
+    if (compressed) {
+        hdr.m_codec.assign(mf.nComp(), compressionCodec);
+        hdr.m_ctol.assign(mf.nComp(), compressionTol);
+    }
 
     const int nspots = (nprocs + (nfiles-1)) / nfiles;   // max spots per file
     const int nfull = nfiles + nprocs - nspots*nfiles;  // the first nfull files are full
@@ -2192,7 +2510,7 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
     const int n_global_fabs = mf.size();
     const int ncomp = mf.nComp();
     const long n_fab_reals = 2*ncomp;
-    const long n_fab_int64 = 1;
+    const long n_fab_int64 = compressed ? 1+ncomp : 1;   // ---- offset and compressed sizes
     const long n_fab_nums = n_fab_reals*sizeof_int64_over_real + n_fab_int64;
     const long n_local_nums = n_fab_nums * n_local_fabs + 1;
     Vector<int64_t> localdata(n_local_nums);
@@ -2205,6 +2523,7 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
     int64_t total_bytes = 0;
     auto pld = (char*)(&(localdata[1]));
     const FABio& fio = FArrayBox::getFABio();
+    Vector<char> cData;   // ---- the compressed data of all local fabs
     for (MFIter mfi(mf); mfi.isValid(); ++mfi)
     {
         std::memcpy(pld, &total_bytes, sizeof(int64_t));
@@ -2212,10 +2531,23 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
 
         const FArrayBox& fab = mf[mfi];
 
-        std::stringstream hss;
-        fio.write_header(hss, fab, ncomp);
-        total_bytes += static_cast<std::streamoff>(hss.tellp());
-        total_bytes += fab.size() * whichRD.numBytes();
+        if (compressed) {
+            const long nPts = fab.box().numPts();
+            for (int icomp = 0; icomp < ncomp; ++icomp) {
+                int64_t csize = FabCompression::Compress(compressionCodec, compressionTol,
+                                                         fab.dataPtr(icomp), nPts, cData);
+                std::memcpy(pld, &csize, sizeof(int64_t));
+                pld += sizeof(int64_t);
+                total_bytes += csize;
+            }
+        } else {
+            if (fabHeader) {
+                std::stringstream hss;
+                fio.write_header(hss, fab, ncomp);
+                total_bytes += static_cast<std::streamoff>(hss.tellp());
+            }
+            total_bytes += fab.size() * whichRD.numBytes();
+        }
 
         // compute min and max
         const Box& bx = mfi.validbox();
@@ -2293,19 +2625,25 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
     }
 #endif
 
-    std::unique_ptr<char,DataDeleter> alldata((char*)(The_Pinned_Arena()->alloc(total_bytes)),
-                                              DataDeleter(The_Pinned_Arena()));
+    // shared_ptr so that the task can be stored in a std::function
+    std::shared_ptr<char> alldata((char*)(The_Pinned_Arena()->alloc(total_bytes)),
+                                  DataDeleter(The_Pinned_Arena()));
     char* p = alldata.get();
     void* ptmp;
-    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    if (compressed) {
+        std::memcpy(p, cData.dataPtr(), cData.size());
+    }
+    for (MFIter mfi(mf); mfi.isValid() && !compressed; ++mfi)
     {
         const FArrayBox& fab = mf[mfi];
-        std::stringstream hss;
-        fio.write_header(hss, fab, ncomp);
-        int nbytes = static_cast<std::streamoff>(hss.tellp());
-        auto tstr = hss.str();
-        std::memcpy(p, tstr.c_str(), nbytes);
-        p += nbytes;
+        if (fabHeader) {
+            std::stringstream hss;
+            fio.write_header(hss, fab, ncomp);
+            int nbytes = static_cast<std::streamoff>(hss.tellp());
+            auto tstr = hss.str();
+            std::memcpy(p, tstr.c_str(), nbytes);
+            p += nbytes;
+        }
         long nreals = fab.size();
         if (doConvert) {
             ptmp = The_Pinned_Arena()->alloc(nreals*sizeof(Real));
@@ -2324,10 +2662,13 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
         p += nreals * whichRD.numBytes();
     }
 
-    auto af = std::async(std::launch::async,
-    [=] (std::unique_ptr<char,DataDeleter> d, Header h, Vector<int64_t> const& gdata)
-         -> WriteAsyncStatus
+    auto& d = alldata;
+    auto& gdata = globaldata;
+    std::shared_ptr<Header> phdr = std::make_shared<Header>(std::move(hdr));
+
+    return [=] () -> WriteAsyncStatus
     {
+        Header& h = *phdr;
         Real tbegin = amrex::second();
         if (myproc == nprocs-1)
         {
@@ -2338,6 +2679,9 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
             h.m_famax.clear();
             h.m_famin.resize(ncomp,std::numeric_limits<Real>::max());
             h.m_famax.resize(ncomp,std::numeric_limits<Real>::lowest());
+            if (compressed) {
+                h.m_csize.resize(n_global_fabs);
+            }
 
             Vector<int64_t> nbytes_on_rank(nprocs,-1L);
             Vector<Vector<int> > gidx(nprocs);
@@ -2373,6 +2717,16 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
                     int64_t nbytes;
                     std::memcpy(&nbytes, pgd, sizeof(int64_t));
                     pgd += sizeof(int64_t);
+
+                    if (compressed) {
+                        h.m_csize[k].resize(ncomp);
+                        for (int icomp = 0; icomp < ncomp; ++icomp) {
+                            int64_t csize;
+                            std::memcpy(&csize, pgd, sizeof(int64_t));
+                            pgd += sizeof(int64_t);
+                            h.m_csize[k][icomp] = csize;
+                        }
+                    }
                     
                     for (int icomp = 0; icomp < ncomp; ++icomp) {
                         Real cmin, cmax;
@@ -2435,6 +2789,7 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
 
         Real t1 = amrex::second();
 
+        bool ok = true;
         if (total_bytes > 0) {
             std::string file_name = amrex::Concatenate(mf_name + FabFileSuffix, ifile, 5);
             std::ofstream ofs;
@@ -2444,6 +2799,7 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
             if (!ofs.good()) amrex::FileOpenFailed(file_name);
             ofs.write(d.get(), total_bytes);
             ofs.close();
+            ok = !ofs.fail();
         }
 
         Real t2 = amrex::second();
@@ -2464,11 +2820,9 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
         status.t_spin = t1-t0;
         status.t_write = t2-t1;
         status.t_send = tend-t2;
+        status.ok = ok;
         return status;
-    },
-    std::move(alldata), std::move(hdr), std::move(globaldata));
-
-    return af;
+    };
 }
 
 std::ostream&
@@ -2477,7 +2831,7 @@ operator<< (std::ostream& os, const WriteAsyncStatus& status)
     os << "total bytes: " << status.nbytes << ", nspins: " << status.nspins
        << ", t_total: " << status.t_total << ", t_header: " << status.t_header
        << ", t_spin: " << status.t_spin << ", t_write: " << status.t_write
-       << ", t_send: " << status.t_send;
+       << ", t_send: " << status.t_send << ", ok: " << status.ok;
     return os;
 }
 
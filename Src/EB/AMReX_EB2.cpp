@@ -7,11 +7,17 @@
 #include <AMReX_EB2_IF_Sphere.H>
 #include <AMReX_EB2_IF_Torus.H>
 #include <AMReX_EB2_IF_Spline.H>
+#include <AMReX_EB2_IF_STL.H>
 #include <AMReX_EB2_GeometryShop.H>
 #include <AMReX_EB2.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
 #include <AMReX.H>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
 
 namespace amrex { namespace EB2 {
 
@@ -63,6 +69,44 @@ const IndexSpace* TopIndexSpaceIfPresent() noexcept {
     return nullptr;
 }
 
+namespace {
+// The eb2.* parameters, which define the geometry, as a checkpoint file key
+std::string parmParseKey ()
+{
+    std::ostringstream table;
+    ParmParse::dumpTable(table);
+    std::istringstream is(table.str());
+    std::string line, key;
+    while (std::getline(is, line)) {
+        if (line.compare(0, 4, "eb2.") == 0 && line.compare(0, 15, "eb2.chkpt_file(") != 0) {
+            key += line + "\n";
+        }
+    }
+
+    // An STL file can change without a change of its name, so its size and
+    // modification time are part of the key.
+    ParmParse pp("eb2");
+    std::string geom_type;
+    if (pp.query("geom_type", geom_type) && geom_type == "stl") {
+        std::string stl_file;
+        pp.get("stl_file", stl_file);
+        long stamp[2] = {-1, -1};
+        if (ParallelDescriptor::IOProcessor()) {
+            struct stat st;
+            if (::stat(stl_file.c_str(), &st) == 0) {
+                stamp[0] = st.st_size;
+                stamp[1] = st.st_mtime;
+            }
+        }
+        ParallelDescriptor::Bcast(stamp, 2, ParallelDescriptor::IOProcessorNumber());
+        key += "stl_file size " + std::to_string(stamp[0])
+            + " mtime " + std::to_string(stamp[1]) + "\n";
+    }
+
+    return key;
+}
+}
+
 void
 Build (const Geometry& geom, int required_coarsening_level,
        int max_coarsening_level, int ngrow)
@@ -71,6 +115,16 @@ Build (const Geometry& geom, int required_coarsening_level,
     std::string geom_type;
     pp.get("geom_type", geom_type);
 
+    std::string chkpt_file;
+    pp.query("chkpt_file", chkpt_file);
+    const std::string key = chkpt_file.empty() ? std::string() : parmParseKey();
+    if (!chkpt_file.empty() &&
+        ReadChkptFile(chkpt_file, key, geom, required_coarsening_level,
+                      max_coarsening_level, ngrow))
+    {
+        return;
+    }
+
     if (geom_type == "all_regular")
     {
         EB2::AllRegularIF rif;
@@ -170,10 +224,180 @@ Build (const Geometry& geom, int required_coarsening_level,
         EB2::Build(gshop, geom, required_coarsening_level,
                    max_coarsening_level, ngrow);
     }
+#if (AMREX_SPACEDIM == 3)
+    else if (geom_type == "stl")
+    {
+        std::string stl_file;
+        pp.get("stl_file", stl_file);
+
+        Real scale = 1.0;
+        pp.query("stl_scale", scale);
+
+        RealArray center{0.0, 0.0, 0.0};
+        pp.query("stl_center", center);
+
+        bool has_fluid_inside = false;
+        pp.query("stl_has_fluid_inside", has_fluid_inside);
+
+        EB2::STLIF sf(stl_file, scale, center, has_fluid_inside);
+
+        EB2::GeometryShop<EB2::STLIF> gshop(sf);
+        EB2::Build(gshop, geom, required_coarsening_level,
+                   max_coarsening_level, ngrow);
+    }
+#endif
     else
     {
         amrex::Abort("geom_type "+geom_type+ " not supported");
     }
+
+    if (!chkpt_file.empty()) {
+        WriteChkptFile(chkpt_file, key, geom, required_coarsening_level,
+                       max_coarsening_level, ngrow);
+    }
+}
+
+namespace {
+const std::string chkpt_file_version("EB2_ChkptFile_V1");
+}
+
+IndexSpaceChkptFile::IndexSpaceChkptFile (const std::string& dirname, const Geometry& geom,
+                                          std::istream& hdr)
+{
+    int nlevels;
+    hdr >> nlevels;
+    m_chkpt_level.reserve(nlevels);
+    for (int ilev = 0; ilev < nlevels; ++ilev)
+    {
+        Box domain;
+        hdr >> domain;
+        const Geometry& g = (ilev == 0) ? geom : amrex::coarsen(m_geom.back(),2);
+        AMREX_ALWAYS_ASSERT(g.Domain() == domain);
+        m_geom.push_back(g);
+        m_domain.push_back(domain);
+        m_chkpt_level.emplace_back(this, g, dirname+"/Level_"+std::to_string(ilev), hdr);
+    }
+}
+
+const Level&
+IndexSpaceChkptFile::getLevel (const Geometry& geom) const
+{
+    auto it = std::find(std::begin(m_domain), std::end(m_domain), geom.Domain());
+    int i = std::distance(m_domain.begin(), it);
+    return m_chkpt_level[i];
+}
+
+const Geometry&
+IndexSpaceChkptFile::getGeometry (const Box& dom) const
+{
+    auto it = std::find(std::begin(m_domain), std::end(m_domain), dom);
+    int i = std::distance(m_domain.begin(), it);
+    return m_geom[i];
+}
+
+void
+WriteChkptFile (const std::string& dirname, const std::string& key,
+                const Geometry& geom, int required_coarsening_level,
+                int max_coarsening_level, int ngrow)
+{
+    BL_PROFILE("EB2::WriteChkptFile()");
+
+    const IndexSpace& ebis = IndexSpace::top();
+
+    Vector<Geometry> geoms{ebis.getGeometry(geom.Domain())};
+    while (geoms.back().Domain() != ebis.coarsestDomain()) {
+        geoms.push_back(ebis.getGeometry(amrex::coarsen(geoms.back().Domain(),2)));
+    }
+    const int nlevels = geoms.size();
+
+    amrex::UtilCreateCleanDirectory(dirname, false);
+    if (ParallelDescriptor::IOProcessor()) {
+        for (int ilev = 0; ilev < nlevels; ++ilev) {
+            const std::string& leveldir = dirname+"/Level_"+std::to_string(ilev);
+            if (!amrex::UtilCreateDirectory(leveldir, 0755)) {
+                amrex::CreateDirectoryFailed(leveldir);
+            }
+        }
+    }
+    ParallelDescriptor::Barrier();
+
+    std::ostringstream hdr;
+    hdr.precision(17);
+    hdr << chkpt_file_version << '\n'
+        << key.size() << '\n' << key << '\n'
+        << required_coarsening_level << ' ' << max_coarsening_level << ' '
+        << ngrow << ' ' << EB2::max_grid_size << '\n'
+        << geom.Coord() << '\n';
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        hdr << geom.ProbLo(idim) << ' ' << geom.ProbHi(idim) << ' '
+            << geom.isPeriodic(idim) << '\n';
+    }
+
+    hdr << nlevels << '\n';
+    for (int ilev = 0; ilev < nlevels; ++ilev) {
+        hdr << geoms[ilev].Domain() << '\n';
+        ebis.getLevel(geoms[ilev]).writeChkptFile(dirname+"/Level_"+std::to_string(ilev), hdr);
+    }
+
+    // The header goes last, so that only complete files are read.
+    ParallelDescriptor::Barrier();
+    if (ParallelDescriptor::IOProcessor()) {
+        std::ofstream ofs(dirname+"/Header");
+        ofs << hdr.str();
+        if (!ofs.good()) {
+            amrex::FileOpenFailed(dirname+"/Header");
+        }
+    }
+}
+
+bool
+ReadChkptFile (const std::string& dirname, const std::string& key,
+               const Geometry& geom, int required_coarsening_level,
+               int max_coarsening_level, int ngrow)
+{
+    BL_PROFILE("EB2::ReadChkptFile()");
+
+    Vector<char> buf;
+    ParallelDescriptor::ReadAndBcastFile(dirname+"/Header", buf, false);
+    if (buf.empty()) return false;
+
+    std::istringstream hdr(std::string(buf.dataPtr()), std::istringstream::in);
+
+    std::string version;
+    std::size_t keysize = 0;
+    hdr >> version >> keysize;
+    hdr.ignore(1);
+    std::string file_key(keysize, ' ');
+    hdr.read(&file_key[0], keysize);
+
+    int rcl, mcl, ng, mgs, coord;
+    hdr >> rcl >> mcl >> ng >> mgs >> coord;
+    bool match = hdr.good() && version == chkpt_file_version && file_key == key
+        && rcl == required_coarsening_level && mcl == max_coarsening_level
+        && ng == ngrow && mgs == EB2::max_grid_size && coord == geom.Coord();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        Real lo, hi;
+        bool periodic;
+        hdr >> lo >> hi >> periodic;
+        match = match && lo == geom.ProbLo(idim) && hi == geom.ProbHi(idim)
+            && periodic == geom.isPeriodic(idim);
+    }
+
+    int nlevels;
+    Box domain;
+    const auto pos = hdr.tellg();
+    hdr >> nlevels >> domain;
+    match = match && domain == geom.Domain();
+
+    if (!match) {
+        amrex::Print() << "EB2::ReadChkptFile: " << dirname
+                       << " was written for a different geometry\n";
+        return false;
+    }
+
+    hdr.seekg(pos);
+    IndexSpace::push(new IndexSpaceChkptFile(dirname, geom, hdr));
+    return true;
 }
 
 namespace {
@@ -0,0 +1,741 @@
+#include <AMReX_EB2_IF_STL.H>
+#include <AMReX_EB2_GeometryShop.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_BLProfiler.H>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace amrex { namespace EB2 {
+
+#if (AMREX_SPACEDIM == 3)
+
+namespace {
+
+// Closest point features of a triangle
+enum { in_face = 0, at_vert0, at_vert1, at_vert2, on_edge01, on_edge12, on_edge20 };
+
+constexpr int bvh_leaf_size = 4;
+
+inline Real dot3 (const Real* a, const Real* b) noexcept
+{
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+inline void cross3 (const Real* a, const Real* b, Real* c) noexcept
+{
+    c[0] = a[1]*b[2] - a[2]*b[1];
+    c[1] = a[2]*b[0] - a[0]*b[2];
+    c[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+// Closest point q on triangle (a,b,c) to p and the feature it lies on.
+// Returns the squared distance.  See Ericson, Real-Time Collision
+// Detection, Section 5.1.5.
+Real closestPoint (const Real* p, const Real* a, const Real* b, const Real* c,
+                   Real* q, int& feature) noexcept
+{
+    Real ab[3], ac[3], ap[3], bp[3], cp[3];
+    for (int d = 0; d < 3; ++d) {
+        ab[d] = b[d]-a[d];
+        ac[d] = c[d]-a[d];
+        ap[d] = p[d]-a[d];
+    }
+
+    auto finish = [&] () -> Real {
+        Real r2 = 0.0;
+        for (int d = 0; d < 3; ++d) r2 += (p[d]-q[d])*(p[d]-q[d]);
+        return r2;
+    };
+
+    const Real d1 = dot3(ab,ap);
+    const Real d2 = dot3(ac,ap);
+    if (d1 <= 0.0 && d2 <= 0.0) {
+        for (int d = 0; d < 3; ++d) q[d] = a[d];
+        feature = at_vert0;
+        return finish();
+    }
+
+    for (int d = 0; d < 3; ++d) bp[d] = p[d]-b[d];
+    const Real d3 = dot3(ab,bp);
+    const Real d4 = dot3(ac,bp);
+    if (d3 >= 0.0 && d4 <= d3) {
+        for (int d = 0; d < 3; ++d) q[d] = b[d];
+        feature = at_vert1;
+        return finish();
+    }
+
+    const Real vc = d1*d4 - d3*d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+        const Real v = d1/(d1-d3);
+        for (int d = 0; d < 3; ++d) q[d] = a[d] + v*ab[d];
+        feature = on_edge01;
+        return finish();
+    }
+
+    for (int d = 0; d < 3; ++d) cp[d] = p[d]-c[d];
+    const Real d5 = dot3(ab,cp);
+    const Real d6 = dot3(ac,cp);
+    if (d6 >= 0.0 && d5 <= d6) {
+        for (int d = 0; d < 3; ++d) q[d] = c[d];
+        feature = at_vert2;
+        return finish();
+    }
+
+    const Real vb = d5*d2 - d1*d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+        const Real w = d2/(d2-d6);
+        for (int d = 0; d < 3; ++d) q[d] = a[d] + w*ac[d];
+        feature = on_edge20;
+        return finish();
+    }
+
+    const Real va = d3*d6 - d5*d4;
+    if (va <= 0.0 && (d4-d3) >= 0.0 && (d5-d6) >= 0.0) {
+        const Real w = (d4-d3)/((d4-d3)+(d5-d6));
+        for (int d = 0; d < 3; ++d) q[d] = b[d] + w*(c[d]-b[d]);
+        feature = on_edge12;
+        return finish();
+    }
+
+    const Real denom = 1.0/(va+vb+vc);
+    const Real v = vb*denom;
+    const Real w = vc*denom;
+    for (int d = 0; d < 3; ++d) q[d] = a[d] + ab[d]*v + ac[d]*w;
+    feature = in_face;
+    return finish();
+}
+
+// Reads the triangles of an STL file, 9 coordinates each.
+void readSTL (const std::string& filename, Vector<Real>& tri)
+{
+    Vector<char> buf;
+    ParallelDescriptor::ReadAndBcastFile(filename, buf);
+    const Long len = static_cast<Long>(buf.size()) - 1;
+    const char* data = buf.data();
+
+    bool binary = false;
+    std::uint32_t ntri = 0;
+    if (len >= 84) {
+        std::memcpy(&ntri, data+80, sizeof(ntri));
+        binary = (84 + 50*static_cast<Long>(ntri) == len);
+    }
+
+    if (binary)
+    {
+        // Little-endian records of a normal, three vertices and a 2-byte
+        // attribute.  The normals are recomputed from the vertex order.
+        tri.resize(9*static_cast<Long>(ntri));
+        for (Long t = 0; t < static_cast<Long>(ntri); ++t) {
+            float f[12];
+            std::memcpy(f, data+84+50*t, sizeof(f));
+            for (int n = 0; n < 9; ++n) {
+                tri[9*t+n] = f[3+n];
+            }
+        }
+    }
+    else
+    {
+        const char* p = data;
+        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') ++p;
+        if (std::strncmp(p, "solid", 5) != 0) {
+            amrex::Abort("EB2::STLIF: "+filename+" is not an STL file");
+        }
+        // Skip the name of the solid, which may contain anything.
+        p = std::strchr(p, '\n');
+        while (p != nullptr && (p = std::strstr(p, "vertex")) != nullptr)
+        {
+            p += 6;
+            Real x[3];
+            char* end = nullptr;
+            int n = 0;
+            for (; n < 3; ++n) {
+                x[n] = std::strtod(p, &end);
+                if (end == p) break;
+                p = end;
+            }
+            if (n == 3) {
+                tri.push_back(x[0]);
+                tri.push_back(x[1]);
+                tri.push_back(x[2]);
+            }
+        }
+        if (tri.size() % 9 != 0) {
+            amrex::Abort("EB2::STLIF: "+filename+" has an incomplete facet");
+        }
+    }
+}
+
+}
+
+struct STLIF::Mesh
+{
+    struct Node
+    {
+        Real lo[3];
+        Real hi[3];
+        int left;   // children of an interior node; -1 for leaves
+        int right;
+        int first;  // triangles [first,first+count) of a leaf
+        int count;
+    };
+
+    // Triangle t has vertices m_xyz[9*t,9*t+9), vertex ids m_vid[3*t,3*t+3),
+    // edge ids m_eid[3*t,3*t+3) for the edges 0-1, 1-2 and 2-0, and unit
+    // normal m_fnorm[3*t,3*t+3).  Triangles are in BVH leaf order.
+    Vector<Real> m_xyz;
+    Vector<int> m_vid;
+    Vector<int> m_eid;
+    Vector<Real> m_fnorm;
+    // Angle-weighted vertex and edge pseudonormals, not normalized.
+    Vector<Real> m_vnorm;
+    Vector<Real> m_enorm;
+    Vector<Node> m_node;
+
+    explicit Mesh (Vector<Real>&& tri);
+
+    int ntri () const noexcept { return static_cast<int>(m_vid.size()/3); }
+
+    int build (Vector<int>& idx, Vector<Real> const& cent, int first, int last);
+
+    //! Nearest triangle to p closer than max_dist, or -1 if there is none;
+    //! guess, if not -1, is a good candidate.  Also returns the distance,
+    //! the closest point q and its pseudonormal.
+    int nearest (const Real* p, int guess, Real max_dist,
+                 Real& dist, Real* q, Real* n) const noexcept;
+
+    //! Does any triangle's bounding box intersect [lo,hi]?
+    bool overlaps (const Real* lo, const Real* hi) const noexcept;
+
+    //! Intersection of the segment from a to a+len*e_dir with the
+    //! triangles.  Returns false if there is none.
+    bool intersect (const Real* a, int dir, Real len, Real& x) const noexcept;
+
+    //! Signed distance s, positive inside, if the surface is closer than
+    //! max_dist.  guess is updated to the nearest triangle.
+    bool signedDistance (const Real* p, Real max_dist, int& guess, Real& s) const noexcept
+    {
+        Real dist, q[3], n[3];
+        const int t = nearest(p, guess, max_dist, dist, q, n);
+        if (t < 0) return false;
+        guess = t;
+        const Real pq[3] = {p[0]-q[0], p[1]-q[1], p[2]-q[2]};
+        s = (dot3(pq,n) > 0.0) ? -dist : dist;
+        return true;
+    }
+};
+
+STLIF::Mesh::Mesh (Vector<Real>&& tri)
+{
+    const int nt0 = static_cast<int>(tri.size()/9);
+
+    // Weld vertices with identical coordinates.
+    Vector<int> vorder(3*nt0);
+    std::iota(vorder.begin(), vorder.end(), 0);
+    std::sort(vorder.begin(), vorder.end(), [&] (int a, int b) {
+        const Real* x = &tri[3*a];
+        const Real* y = &tri[3*b];
+        return std::lexicographical_compare(x, x+3, y, y+3);
+    });
+    Vector<int> vid0(3*nt0);
+    int nv = 0;
+    for (int i = 0; i < 3*nt0; ++i) {
+        const Real* x = &tri[3*vorder[i]];
+        if (i == 0 || !std::equal(x, x+3, &tri[3*vorder[i-1]])) ++nv;
+        vid0[vorder[i]] = nv-1;
+    }
+    vorder.clear();
+
+    // Drop degenerate triangles and compute unit normals.
+    Vector<int> keep;
+    keep.reserve(nt0);
+    Vector<Real> fnorm0;
+    fnorm0.reserve(3*nt0);
+    for (int t = 0; t < nt0; ++t) {
+        const Real* a = &tri[9*t];
+        Real ab[3], ac[3], n[3];
+        for (int d = 0; d < 3; ++d) {
+            ab[d] = a[3+d]-a[d];
+            ac[d] = a[6+d]-a[d];
+        }
+        cross3(ab, ac, n);
+        const Real nn = std::sqrt(dot3(n,n));
+        if (nn > 0.0 && vid0[3*t] != vid0[3*t+1] && vid0[3*t+1] != vid0[3*t+2]
+                     && vid0[3*t+2] != vid0[3*t])
+        {
+            keep.push_back(t);
+            for (int d = 0; d < 3; ++d) fnorm0.push_back(n[d]/nn);
+        }
+    }
+    const int nt = static_cast<int>(keep.size());
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nt > 0, "EB2::STLIF: no triangles");
+
+    // Edges shared by triangles
+    Vector<std::pair<std::pair<int,int>,int> > edges(3*nt);
+    for (int t = 0; t < nt; ++t) {
+        for (int e = 0; e < 3; ++e) {
+            int v0 = vid0[3*keep[t]+e];
+            int v1 = vid0[3*keep[t]+(e+1)%3];
+            edges[3*t+e] = std::make_pair(std::make_pair(std::min(v0,v1),std::max(v0,v1)), 3*t+e);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    Vector<int> eid0(3*nt);
+    int ne = 0;
+    for (int i = 0; i < 3*nt; ++i) {
+        if (i == 0 || edges[i].first != edges[i-1].first) ++ne;
+        eid0[edges[i].second] = ne-1;
+    }
+    edges.clear();
+
+    m_vnorm.resize(3*nv, 0.0);
+    m_enorm.resize(3*ne, 0.0);
+    for (int t = 0; t < nt; ++t) {
+        const Real* n = &fnorm0[3*t];
+        const Real* x = &tri[9*keep[t]];
+        for (int e = 0; e < 3; ++e) {
+            for (int d = 0; d < 3; ++d) m_enorm[3*eid0[3*t+e]+d] += n[d];
+            // angle at vertex e
+            const Real* x0 = x + 3*e;
+            const Real* x1 = x + 3*((e+1)%3);
+            const Real* x2 = x + 3*((e+2)%3);
+            Real u[3], w[3], c[3];
+            for (int d = 0; d < 3; ++d) {
+                u[d] = x1[d]-x0[d];
+                w[d] = x2[d]-x0[d];
+            }
+            cross3(u, w, c);
+            const Real angle = std::atan2(std::sqrt(dot3(c,c)), dot3(u,w));
+            for (int d = 0; d < 3; ++d) m_vnorm[3*vid0[3*keep[t]+e]+d] += angle*n[d];
+        }
+    }
+
+    // Bounding volume hierarchy
+    Vector<int> idx(nt);
+    std::iota(idx.begin(), idx.end(), 0);
+    Vector<Real> cent(3*nt);
+    for (int t = 0; t < nt; ++t) {
+        const Real* x = &tri[9*keep[t]];
+        for (int d = 0; d < 3; ++d) cent[3*t+d] = (x[d]+x[3+d]+x[6+d])*(1./3.);
+    }
+    m_node.reserve(2*(nt/bvh_leaf_size+1));
+    m_xyz.resize(9*nt);
+    m_vid.resize(3*nt);
+    m_eid.resize(3*nt);
+    m_fnorm.resize(3*nt);
+    // Build sorts idx into leaf order; the triangle data follow it.
+    for (int t = 0; t < nt; ++t) {
+        const Real* x = &tri[9*keep[t]];
+        std::copy(x, x+9, &m_xyz[9*t]);
+    }
+    build(idx, cent, 0, nt);
+
+    Vector<Real> xyz(9*nt);
+    for (int i = 0; i < nt; ++i) {
+        const int t = idx[i];
+        std::copy(&m_xyz[9*t], &m_xyz[9*t]+9, &xyz[9*i]);
+        for (int e = 0; e < 3; ++e) {
+            m_vid[3*i+e] = vid0[3*keep[t]+e];
+            m_eid[3*i+e] = eid0[3*t+e];
+            m_fnorm[3*i+e] = fnorm0[3*t+e];
+        }
+    }
+    std::swap(m_xyz, xyz);
+}
+
+int
+STLIF::Mesh::build (Vector<int>& idx, Vector<Real> const& cent, int first, int last)
+{
+    const int inode = static_cast<int>(m_node.size());
+    m_node.push_back(Node());
+
+    Real lo[3], hi[3], clo[3], chi[3];
+    for (int d = 0; d < 3; ++d) {
+        lo[d] = clo[d] =  std::numeric_limits<Real>::max();
+        hi[d] = chi[d] = -std::numeric_limits<Real>::max();
+    }
+    for (int i = first; i < last; ++i) {
+        const Real* x = &m_xyz[9*idx[i]];
+        for (int d = 0; d < 3; ++d) {
+            lo[d] = std::min({lo[d], x[d], x[3+d], x[6+d]});
+            hi[d] = std::max({hi[d], x[d], x[3+d], x[6+d]});
+            clo[d] = std::min(clo[d], cent[3*idx[i]+d]);
+            chi[d] = std::max(chi[d], cent[3*idx[i]+d]);
+        }
+    }
+
+    int left = -1, right = -1;
+    if (last-first > bvh_leaf_size)
+    {
+        // Median split along the longest extent of the centroids
+        int dir = 0;
+        for (int d = 1; d < 3; ++d) {
+            if (chi[d]-clo[d] > chi[dir]-clo[dir]) dir = d;
+        }
+        const int mid = (first+last)/2;
+        std::nth_element(idx.begin()+first, idx.begin()+mid, idx.begin()+last,
+                         [&] (int a, int b) { return cent[3*a+dir] < cent[3*b+dir]; });
+        left = build(idx, cent, first, mid);
+        right = build(idx, cent, mid, last);
+    }
+
+    Node& node = m_node[inode];
+    for (int d = 0; d < 3; ++d) {
+        node.lo[d] = lo[d];
+        node.hi[d] = hi[d];
+    }
+    node.left = left;
+    node.right = right;
+    node.first = first;
+    node.count = last-first;
+    return inode;
+}
+
+int
+STLIF::Mesh::nearest (const Real* p, int guess, Real max_dist,
+                      Real& dist, Real* q, Real* n) const noexcept
+{
+    Real best = (max_dist < std::sqrt(std::numeric_limits<Real>::max()))
+        ? max_dist*max_dist : std::numeric_limits<Real>::max();
+    int tbest = -1, fbest = in_face;
+
+    auto test = [&] (int t) {
+        Real qt[3];
+        int f;
+        const Real* x = &m_xyz[9*t];
+        const Real r2 = closestPoint(p, x, x+3, x+6, qt, f);
+        if (r2 < best) {
+            best = r2;
+            tbest = t;
+            fbest = f;
+            q[0] = qt[0]; q[1] = qt[1]; q[2] = qt[2];
+        }
+    };
+
+    auto boxDist2 = [&] (const Node& node) -> Real {
+        Real r2 = 0.0;
+        for (int d = 0; d < 3; ++d) {
+            const Real s = std::max({node.lo[d]-p[d], p[d]-node.hi[d], Real(0.0)});
+            r2 += s*s;
+        }
+        return r2;
+    };
+
+    if (guess >= 0) test(guess);
+
+    std::pair<int,Real> stack[64];
+    int top = 0;
+    stack[top++] = std::make_pair(0, boxDist2(m_node[0]));
+    while (top > 0)
+    {
+        const auto item = stack[--top];
+        if (item.second >= best) continue;
+        const Node& node = m_node[item.first];
+        if (node.left < 0) {
+            for (int t = node.first; t < node.first+node.count; ++t) {
+                test(t);
+            }
+        } else {
+            const Real dl = boxDist2(m_node[node.left]);
+            const Real dr = boxDist2(m_node[node.right]);
+            // Visit the nearer child first.
+            if (dl <= dr) {
+                if (dr < best) stack[top++] = std::make_pair(node.right, dr);
+                if (dl < best) stack[top++] = std::make_pair(node.left, dl);
+            } else {
+                if (dl < best) stack[top++] = std::make_pair(node.left, dl);
+                if (dr < best) stack[top++] = std::make_pair(node.right, dr);
+            }
+        }
+    }
+
+    dist = std::sqrt(best);
+    if (tbest < 0) return tbest;
+
+    const Real* nrm;
+    switch (fbest) {
+    case in_face:   nrm = &m_fnorm[3*tbest];               break;
+    case at_vert0:  nrm = &m_vnorm[3*m_vid[3*tbest  ]];    break;
+    case at_vert1:  nrm = &m_vnorm[3*m_vid[3*tbest+1]];    break;
+    case at_vert2:  nrm = &m_vnorm[3*m_vid[3*tbest+2]];    break;
+    case on_edge01: nrm = &m_enorm[3*m_eid[3*tbest  ]];    break;
+    case on_edge12: nrm = &m_enorm[3*m_eid[3*tbest+1]];    break;
+    default:        nrm = &m_enorm[3*m_eid[3*tbest+2]];
+    }
+    n[0] = nrm[0]; n[1] = nrm[1]; n[2] = nrm[2];
+
+    return tbest;
+}
+
+bool
+STLIF::Mesh::overlaps (const Real* lo, const Real* hi) const noexcept
+{
+    auto disjoint = [&] (const Real* blo, const Real* bhi) -> bool {
+        return blo[0] > hi[0] || bhi[0] < lo[0]
+            || blo[1] > hi[1] || bhi[1] < lo[1]
+            || blo[2] > hi[2] || bhi[2] < lo[2];
+    };
+
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const Node& node = m_node[stack[--top]];
+        if (disjoint(node.lo, node.hi)) continue;
+        if (node.left < 0) {
+            for (int t = node.first; t < node.first+node.count; ++t) {
+                const Real* x = &m_xyz[9*t];
+                Real tlo[3], thi[3];
+                for (int d = 0; d < 3; ++d) {
+                    tlo[d] = std::min({x[d], x[3+d], x[6+d]});
+                    thi[d] = std::max({x[d], x[3+d], x[6+d]});
+                }
+                if (!disjoint(tlo, thi)) return true;
+            }
+        } else {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+    return false;
+}
+
+bool
+STLIF::Mesh::intersect (const Real* a, int dir, Real len, Real& x) const noexcept
+{
+    const int d1 = (dir+1)%3;
+    const int d2 = (dir+2)%3;
+    const Real u = a[d1];
+    const Real v = a[d2];
+    const Real xlo = a[dir];
+    const Real xhi = a[dir]+len;
+
+    bool found = false;
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const Node& node = m_node[stack[--top]];
+        if (u < node.lo[d1] || u > node.hi[d1] || v < node.lo[d2] || v > node.hi[d2] ||
+            xhi < node.lo[dir] || xlo > node.hi[dir]) continue;
+        if (node.left < 0) {
+            for (int t = node.first; t < node.first+node.count; ++t) {
+                // Barycentric coordinates of the segment's projection onto
+                // the plane normal to dir
+                const Real* p0 = &m_xyz[9*t];
+                const Real* p1 = p0+3;
+                const Real* p2 = p0+6;
+                const Real w0 = (p1[d1]-u)*(p2[d2]-v) - (p1[d2]-v)*(p2[d1]-u);
+                const Real w1 = (p2[d1]-u)*(p0[d2]-v) - (p2[d2]-v)*(p0[d1]-u);
+                const Real w2 = (p0[d1]-u)*(p1[d2]-v) - (p0[d2]-v)*(p1[d1]-u);
+                const Real area = w0+w1+w2;
+                if (area == 0.0) continue;
+                if ((w0 < 0.0 || w1 < 0.0 || w2 < 0.0) &&
+                    (w0 > 0.0 || w1 > 0.0 || w2 > 0.0)) continue;
+                const Real xt = (w0*p0[dir] + w1*p1[dir] + w2*p2[dir]) / area;
+                if (xt >= xlo && xt <= xhi && (!found || xt < x)) {
+                    x = xt;
+                    found = true;
+                }
+            }
+        } else {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+    return found;
+}
+
+STLIF::STLIF (const std::string& a_filename, Real a_scale,
+              const RealArray& a_center, bool a_inside)
+    : m_sign( a_inside ? -1.0 : 1.0 )
+{
+    BL_PROFILE("EB2::STLIF()");
+
+    Vector<Real> tri;
+    readSTL(a_filename, tri);
+    for (Long i = 0; i < tri.size(); i += 3) {
+        for (int d = 0; d < 3; ++d) {
+            tri[i+d] = a_center[d] + a_scale*tri[i+d];
+        }
+    }
+
+    m_mesh = std::make_shared<Mesh const>(std::move(tri));
+}
+
+int
+STLIF::numTriangles () const noexcept
+{
+    return m_mesh->ntri();
+}
+
+Real
+STLIF::operator() (const RealArray& p) const noexcept
+{
+    int guess = -1;
+    Real s = 0.0;
+    m_mesh->signedDistance(p.data(), std::numeric_limits<Real>::max(), guess, s);
+    return m_sign * s;
+}
+
+// Fills v with the signed distance, positive in the body, of the nodes of
+// bx clamped to levelset_band cells.  Nodes whose neighbor is known to be
+// far enough from the surface are only clamped.  The others search within
+// twice the band, starting from the last nearest triangle; if the surface
+// is farther, they are on the same side as their neighbor.
+int
+STLIF::fillBox (const Box& bx, const Geometry& geom, Real* v, bool stop_if_mixed) const noexcept
+{
+    const auto problo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+    const Real band = levelset_band * std::max({dx[0],dx[1],dx[2]});
+
+    const auto lo = amrex::lbound(bx);
+    const auto len = amrex::length(bx);
+    const Long nxy = static_cast<Long>(len.x)*len.y;
+
+    // Lower bounds on the distances
+    Vector<Real> lb(bx.numPts());
+
+    int nbody = 0, nfluid = 0;
+    int guess = -1;
+    Long n = 0;
+    for         (int k = 0; k < len.z; ++k) {
+        for     (int j = 0; j < len.y; ++j) {
+            for (int i = 0; i < len.x; ++i, ++n) {
+                // The distance changes by at most h between neighbors.
+                Long nb = -1;
+                Real lbn = std::numeric_limits<Real>::lowest();
+                if (i > 0 && lb[n-1]-dx[0] > lbn) {
+                    nb = n-1;
+                    lbn = lb[nb]-dx[0];
+                }
+                if (j > 0 && lb[n-len.x]-dx[1] > lbn) {
+                    nb = n-len.x;
+                    lbn = lb[nb]-dx[1];
+                }
+                if (k > 0 && lb[n-nxy]-dx[2] > lbn) {
+                    nb = n-nxy;
+                    lbn = lb[nb]-dx[2];
+                }
+
+                if (lbn >= band) {
+                    lb[n] = lbn;
+                    v[n] = std::copysign(band, v[nb]);
+                } else {
+                    const Real p[3] = {problo[0]+(i+lo.x)*dx[0],
+                                       problo[1]+(j+lo.y)*dx[1],
+                                       problo[2]+(k+lo.z)*dx[2]};
+                    const Real max_dist = (nb >= 0) ? 2.*band : std::numeric_limits<Real>::max();
+                    Real s;
+                    if (m_mesh->signedDistance(p, max_dist, guess, s)) {
+                        s *= m_sign;
+                        lb[n] = std::abs(s);
+                        v[n] = std::max(-band, std::min(band, s));
+                    } else {
+                        lb[n] = max_dist;
+                        v[n] = std::copysign(band, v[nb]);
+                    }
+                }
+
+                if (v[n] > 0.0) {
+                    ++nbody;
+                } else if (v[n] < 0.0) {
+                    ++nfluid;
+                }
+                if (stop_if_mixed && nbody > 0 && nfluid > 0) {
+                    return GeometryShop<STLIF>::mixedcells;
+                }
+            }
+        }
+    }
+
+    if (nbody == 0) {
+        return GeometryShop<STLIF>::allregular;
+    } else if (nfluid == 0) {
+        return GeometryShop<STLIF>::allcovered;
+    } else {
+        return GeometryShop<STLIF>::mixedcells;
+    }
+}
+
+int
+STLIF::getBoxType (const Box& bx, const Geometry& geom) const noexcept
+{
+    const Real* problo = geom.ProbLo();
+    const Real* dx = geom.CellSize();
+    const Real lo[3] = {problo[0]+bx.smallEnd(0)*dx[0],
+                        problo[1]+bx.smallEnd(1)*dx[1],
+                        problo[2]+bx.smallEnd(2)*dx[2]};
+    const Real hi[3] = {problo[0]+bx.bigEnd(0)*dx[0],
+                        problo[1]+bx.bigEnd(1)*dx[1],
+                        problo[2]+bx.bigEnd(2)*dx[2]};
+
+    if (m_mesh->overlaps(lo, hi)) {
+        Vector<Real> v(bx.numPts());
+        return fillBox(bx, geom, v.data(), true);
+    } else {
+        // The surface does not pass through the box.
+        int guess = -1;
+        Real s = 0.0;
+        m_mesh->signedDistance(lo, std::numeric_limits<Real>::max(), guess, s);
+        return (m_sign*s > 0.0) ? GeometryShop<STLIF>::allcovered : GeometryShop<STLIF>::allregular;
+    }
+}
+
+void
+STLIF::fillFab (BaseFab<Real>& levelset, const Geometry& geom) const noexcept
+{
+    fillBox(levelset.box(), geom, levelset.dataPtr(), false);
+}
+
+void
+STLIF::getIntercept (Array<BaseFab<Real>,AMREX_SPACEDIM>& inter_fab,
+                     Array<BaseFab<Type_t>,AMREX_SPACEDIM> const& type_fab,
+                     Geometry const& geom) const noexcept
+{
+    auto const& dx = geom.CellSizeArray();
+    auto const& problo = geom.ProbLoArray();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        Array4<Real> const& inter = inter_fab[idim].array();
+        Array4<Type_t const> const& type = type_fab[idim].array();
+        const Box& bx = inter_fab[idim].box();
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            if (type(i,j,k) == Type::irregular) {
+                const Real a[3] = {problo[0]+i*dx[0],
+                                   problo[1]+j*dx[1],
+                                   problo[2]+k*dx[2]};
+                Real x;
+                if (!m_mesh->intersect(a, idim, dx[idim], x)) {
+                    // The edge only grazes the surface.  Fall back to the
+                    // function values.
+                    GpuArray<Real,AMREX_SPACEDIM> b {a[0], a[1], a[2]};
+                    b[idim] += dx[idim];
+                    const Real fa = (*this)({a[0], a[1], a[2]});
+                    const Real fb = (*this)({b[0], b[1], b[2]});
+                    if (fa*fb <= 0.0) {
+                        x = BrentRootFinder({a[0], a[1], a[2]}, b, idim, *this);
+                    } else {
+                        x = a[idim] + 0.5*dx[idim];
+                    }
+                }
+                inter(i,j,k) = x;
+            } else {
+                inter(i,j,k) = std::numeric_limits<Real>::quiet_NaN();
+            }
+        });
+    }
+}
+
+#endif
+
+}}
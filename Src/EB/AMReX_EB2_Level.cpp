@@ -845,4 +845,112 @@ Level::fillLevelSet (MultiFab& levelset, const Geometry& geom) const
     }
 }
         
+void
+Level::writeChkptFile (const std::string& dirname, std::ostream& os) const
+{
+    if (ParallelDescriptor::IOProcessor()) {
+        os << m_allregular << '\n' << m_ngrow << '\n';
+        m_covered_grids.writeOn(os);
+        os << '\n';
+        m_grids.writeOn(os);
+        os << '\n';
+        if (!m_allregular) {
+            os << m_volfrac.nGrow() << ' ' << m_levelset.nGrow() << '\n';
+        }
+    }
+
+    if (m_allregular) return;
+
+    // The flags are 32-bit integers, which doubles hold exactly.
+    MultiFab cellflag(m_grids, m_dmap, 1, m_cellflag.nGrow());
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(cellflag); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.fabbox();
+        auto const& flag = m_cellflag.const_array(mfi);
+        auto const& a = cellflag.array(mfi);
+        AMREX_HOST_DEVICE_FOR_3D ( bx, i, j, k,
+        {
+            a(i,j,k) = static_cast<Real>(flag(i,j,k).getValue());
+        });
+    }
+
+    VisMF::Write(cellflag, dirname+"/cellflag");
+    VisMF::Write(m_volfrac, dirname+"/volfrac");
+    VisMF::Write(m_centroid, dirname+"/centroid");
+    VisMF::Write(m_bndryarea, dirname+"/bndryarea");
+    VisMF::Write(m_bndrycent, dirname+"/bndrycent");
+    VisMF::Write(m_bndrynorm, dirname+"/bndrynorm");
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        VisMF::Write(m_areafrac[idim], dirname+"/areafrac_"+std::to_string(idim));
+        VisMF::Write(m_facecent[idim], dirname+"/facecent_"+std::to_string(idim));
+    }
+    VisMF::Write(m_levelset, dirname+"/levelset");
+}
+
+ChkptFileLevel::ChkptFileLevel (IndexSpace const* is, const Geometry& geom,
+                                const std::string& dirname, std::istream& hdr)
+    : Level(is, geom)
+{
+    BL_PROFILE("EB2::ChkptFileLevel()");
+
+    hdr >> m_allregular >> m_ngrow;
+    m_covered_grids.readFrom(hdr);
+    m_grids.readFrom(hdr);
+
+    if (m_allregular) {
+        m_ok = true;
+        return;
+    }
+
+    int ng, ls_ng;
+    hdr >> ng >> ls_ng;
+
+    m_dmap = DistributionMapping(m_grids);
+
+    MFInfo mf_info;
+    mf_info.SetTag("EB2::Level");
+    MultiFab cellflag(m_grids, m_dmap, 1, ng, mf_info);
+    VisMF::ReadMapped(cellflag, dirname+"/cellflag");
+    m_cellflag.define(m_grids, m_dmap, 1, ng, mf_info);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(cellflag); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.fabbox();
+        auto const& a = cellflag.const_array(mfi);
+        auto const& flag = m_cellflag.array(mfi);
+        AMREX_HOST_DEVICE_FOR_3D ( bx, i, j, k,
+        {
+            flag(i,j,k) = EBCellFlag(static_cast<uint32_t>(a(i,j,k)));
+        });
+    }
+
+    m_volfrac.define(m_grids, m_dmap, 1, ng, mf_info);
+    VisMF::ReadMapped(m_volfrac, dirname+"/volfrac");
+    m_centroid.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    VisMF::ReadMapped(m_centroid, dirname+"/centroid");
+    m_bndryarea.define(m_grids, m_dmap, 1, ng, mf_info);
+    VisMF::ReadMapped(m_bndryarea, dirname+"/bndryarea");
+    m_bndrycent.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    VisMF::ReadMapped(m_bndrycent, dirname+"/bndrycent");
+    m_bndrynorm.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    VisMF::ReadMapped(m_bndrynorm, dirname+"/bndrynorm");
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_areafrac[idim].define(amrex::convert(m_grids, IntVect::TheDimensionVector(idim)),
+                                m_dmap, 1, ng, mf_info);
+        VisMF::ReadMapped(m_areafrac[idim], dirname+"/areafrac_"+std::to_string(idim));
+        m_facecent[idim].define(amrex::convert(m_grids, IntVect::TheDimensionVector(idim)),
+                                m_dmap, AMREX_SPACEDIM-1, ng, mf_info);
+        VisMF::ReadMapped(m_facecent[idim], dirname+"/facecent_"+std::to_string(idim));
+    }
+    m_levelset.define(amrex::convert(m_grids,IntVect::TheNodeVector()), m_dmap, 1, ls_ng, mf_info);
+    VisMF::ReadMapped(m_levelset, dirname+"/levelset");
+
+    m_ok = true;
+}
+
 }}
@@ -0,0 +1,170 @@
+#include <AMReX_EBCutCells.H>
+#include <AMReX_MultiCutFab.H>
+#include <AMReX_MultiFab.H>
+
+#ifdef AMREX_USE_GPU
+#include <AMReX_Scan.H>
+#endif
+
+namespace amrex {
+
+EBCutCellsArray
+EBCutCells::const_array () const noexcept
+{
+    EBCutCellsArray r;
+    r.cells = m_cells.dataPtr();
+    r.data = m_data.dataPtr();
+    if (!m_index.empty()) {
+        const auto lo = amrex::lbound(m_box);
+        const auto hi = amrex::ubound(m_box);
+        r.index = Array4<int const>(m_index.dataPtr(), lo, Dim3{hi.x+1,hi.y+1,hi.z+1}, 1);
+    }
+    r.ncells = m_cells.size();
+    return r;
+}
+
+void
+EBCutCells::define (const Box& bx, Array4<EBCellFlag const> const& flag,
+                    Array4<Real const> const& volfrac,
+                    Array4<Real const> const& centroid,
+                    Array4<Real const> const& bndryarea,
+                    Array4<Real const> const& bndrycent,
+                    Array4<Real const> const& bndrynorm,
+                    Array<Array4<Real const>,AMREX_SPACEDIM> const& areafrac,
+                    Array<Array4<Real const>,AMREX_SPACEDIM> const& facecent)
+{
+    m_box = bx;
+    const int npts = bx.numPts();
+    m_index.resize(npts);
+    int* AMREX_RESTRICT pindex = m_index.dataPtr();
+
+    // The index of a cut cell is the number of cut cells before it.
+#ifdef AMREX_USE_GPU
+    const int ncells = Scan::PrefixSum<int>(npts,
+        [=] AMREX_GPU_DEVICE (int n) -> int
+        {
+            const IntVect iv = bx.atOffset(n);
+            return flag(iv).isSingleValued();
+        },
+        [=] AMREX_GPU_DEVICE (int n, int const& s)
+        {
+            const IntVect iv = bx.atOffset(n);
+            pindex[n] = flag(iv).isSingleValued() ? s : -1;
+        },
+        Scan::Type::exclusive);
+#else
+    int ncells = 0;
+    for (int n = 0; n < npts; ++n) {
+        const IntVect iv = bx.atOffset(n);
+        pindex[n] = flag(iv).isSingleValued() ? ncells++ : -1;
+    }
+#endif
+
+    m_cells.resize(ncells);
+    m_data.resize(ncells);
+    IntVect* AMREX_RESTRICT pcells = m_cells.dataPtr();
+    EBCutCellData* AMREX_RESTRICT pdata = m_data.dataPtr();
+
+    const auto index = const_array().index;
+    AMREX_HOST_DEVICE_FOR_3D(bx, i, j, k,
+    {
+        const int n = index(i,j,k);
+        if (n >= 0) {
+            pcells[n] = IntVect(AMREX_D_DECL(i,j,k));
+            EBCutCellData& d = pdata[n];
+            d.volfrac = volfrac(i,j,k);
+            d.bndryarea = bndryarea(i,j,k);
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                d.centroid[idim] = centroid(i,j,k,idim);
+                d.bndrycent[idim] = bndrycent(i,j,k,idim);
+                d.bndrynorm[idim] = bndrynorm(i,j,k,idim);
+                const int ih = i + (idim == 0);
+                const int jh = j + (idim == 1);
+                const int kh = k + (idim == 2);
+                d.areafrac[2*idim  ] = areafrac[idim](i ,j ,k );
+                d.areafrac[2*idim+1] = areafrac[idim](ih,jh,kh);
+                for (int n2 = 0; n2 < AMREX_SPACEDIM-1; ++n2) {
+                    d.facecent[2*idim  ][n2] = facecent[idim](i ,j ,k ,n2);
+                    d.facecent[2*idim+1][n2] = facecent[idim](ih,jh,kh,n2);
+                }
+            }
+        }
+    });
+    Gpu::synchronize();
+}
+
+Long
+EBCutCells::nBytes () const noexcept
+{
+    return sizeof(IntVect)*m_cells.size() + sizeof(EBCutCellData)*m_data.size()
+        + sizeof(int)*m_index.size();
+}
+
+MultiEBCutCells::MultiEBCutCells (const FabArray<EBCellFlagFab>& cellflags, const MultiFab& volfrac,
+                                  const MultiCutFab& centroid, const MultiCutFab& bndryarea,
+                                  const MultiCutFab& bndrycent, const MultiCutFab& bndrynorm,
+                                  const Array<const MultiCutFab*,AMREX_SPACEDIM>& areafrac,
+                                  const Array<const MultiCutFab*,AMREX_SPACEDIM>& facecent,
+                                  int ngrow)
+{
+    define(cellflags, volfrac, centroid, bndryarea, bndrycent, bndrynorm, areafrac, facecent, ngrow);
+}
+
+void
+MultiEBCutCells::define (const FabArray<EBCellFlagFab>& cellflags, const MultiFab& volfrac,
+                         const MultiCutFab& centroid, const MultiCutFab& bndryarea,
+                         const MultiCutFab& bndrycent, const MultiCutFab& bndrynorm,
+                         const Array<const MultiCutFab*,AMREX_SPACEDIM>& areafrac,
+                         const Array<const MultiCutFab*,AMREX_SPACEDIM>& facecent,
+                         int ngrow)
+{
+    BL_PROFILE("MultiEBCutCells::define()");
+
+    AMREX_ASSERT(ngrow <= volfrac.nGrow() && ngrow <= centroid.nGrow() &&
+                 ngrow <= bndryarea.nGrow() && ngrow <= areafrac[0]->nGrow());
+
+    m_ngrow = ngrow;
+    m_data.define(cellflags.boxArray(), cellflags.DistributionMap());
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(cellflags); mfi.isValid(); ++mfi)
+    {
+        if (cellflags[mfi].getType() == FabType::singlevalued)
+        {
+            m_data[mfi].define(mfi.growntilebox(ngrow), cellflags.const_array(mfi),
+                               volfrac.const_array(mfi), centroid.const_array(mfi),
+                               bndryarea.const_array(mfi), bndrycent.const_array(mfi),
+                               bndrynorm.const_array(mfi),
+                               {AMREX_D_DECL(areafrac[0]->const_array(mfi),
+                                             areafrac[1]->const_array(mfi),
+                                             areafrac[2]->const_array(mfi))},
+                               {AMREX_D_DECL(facecent[0]->const_array(mfi),
+                                             facecent[1]->const_array(mfi),
+                                             facecent[2]->const_array(mfi))});
+        }
+    }
+}
+
+Long
+MultiEBCutCells::numCutCells () const noexcept
+{
+    Long r = 0;
+    for (MFIter mfi(m_data); mfi.isValid(); ++mfi) {
+        r += m_data[mfi].size();
+    }
+    return r;
+}
+
+Long
+MultiEBCutCells::nBytes () const noexcept
+{
+    Long r = 0;
+    for (MFIter mfi(m_data); mfi.isValid(); ++mfi) {
+        r += m_data[mfi].nBytes();
+    }
+    return r;
+}
+
+}
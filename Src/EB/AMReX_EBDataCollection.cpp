@@ -2,6 +2,7 @@
 #include <AMReX_EBDataCollection.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_MultiCutFab.H>
+#include <AMReX_EBCutCells.H>
 
 #include <AMReX_EB2_Level.H>
 
@@ -35,7 +36,7 @@ EBDataCollection::EBDataCollection (const EB2::Level& a_level,
         a_level.fillCentroid(*m_centroid, m_geom);
     }
 
-    if (m_support == EBSupport::full)
+    if (m_support >= EBSupport::cutcell)
     {
         const int ng = m_ngrow[2];
 
@@ -57,6 +58,35 @@ EBDataCollection::EBDataCollection (const EB2::Level& a_level,
         a_level.fillAreaFrac(m_areafrac, m_geom);
         a_level.fillFaceCent(m_facecent, m_geom);
     }
+
+    if (m_support == EBSupport::cutcell)
+    {
+        buildCutCells();
+
+        // Only the cut cells are kept.
+        delete m_bndrycent;
+        delete m_bndryarea;
+        delete m_bndrynorm;
+        m_bndrycent = nullptr;
+        m_bndryarea = nullptr;
+        m_bndrynorm = nullptr;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            delete m_areafrac[idim];
+            delete m_facecent[idim];
+            m_areafrac[idim] = nullptr;
+            m_facecent[idim] = nullptr;
+        }
+    }
+}
+
+void
+EBDataCollection::buildCutCells () const
+{
+    m_cutcells = new MultiEBCutCells(*m_cellflags, *m_volfrac, *m_centroid,
+                                     *m_bndryarea, *m_bndrycent, *m_bndrynorm,
+                                     {AMREX_D_DECL(m_areafrac[0], m_areafrac[1], m_areafrac[2])},
+                                     {AMREX_D_DECL(m_facecent[0], m_facecent[1], m_facecent[2])},
+                                     std::min(m_ngrow[1], m_ngrow[2]));
 }
 
 EBDataCollection::~EBDataCollection ()
@@ -71,6 +101,7 @@ EBDataCollection::~EBDataCollection ()
         delete m_areafrac[idim];
         delete m_facecent[idim];
     }
+    delete m_cutcells;
 }
 
 const FabArray<EBCellFlagFab>&
@@ -97,36 +128,52 @@ EBDataCollection::getCentroid () const
 const MultiCutFab&
 EBDataCollection::getBndryCent () const
 {
-    AMREX_ASSERT(m_bndrycent != nullptr);
+    AMREX_ASSERT_WITH_MESSAGE(m_bndrycent != nullptr,
+                              "EBDataCollection::getBndryCent: EBSupport::full is required");
     return *m_bndrycent;
 }
 
 const MultiCutFab&
 EBDataCollection::getBndryArea () const
 {
-    AMREX_ASSERT(m_bndryarea != nullptr);
+    AMREX_ASSERT_WITH_MESSAGE(m_bndryarea != nullptr,
+                              "EBDataCollection::getBndryArea: EBSupport::full is required");
     return *m_bndryarea;
 }
 
 Array<const MultiCutFab*, AMREX_SPACEDIM>
 EBDataCollection::getAreaFrac () const
 {
-    AMREX_ASSERT(m_areafrac[0] != nullptr);
+    AMREX_ASSERT_WITH_MESSAGE(m_areafrac[0] != nullptr,
+                              "EBDataCollection::getAreaFrac: EBSupport::full is required");
     return {AMREX_D_DECL(m_areafrac[0], m_areafrac[1], m_areafrac[2])};
 }
 
 Array<const MultiCutFab*, AMREX_SPACEDIM>
 EBDataCollection::getFaceCent () const
 {
-    AMREX_ASSERT(m_facecent[0] != nullptr);
+    AMREX_ASSERT_WITH_MESSAGE(m_facecent[0] != nullptr,
+                              "EBDataCollection::getFaceCent: EBSupport::full is required");
     return {AMREX_D_DECL(m_facecent[0], m_facecent[1], m_facecent[2])};
 }
 
 const MultiCutFab&
 EBDataCollection::getBndryNormal () const
 {
-    AMREX_ASSERT(m_bndrynorm != nullptr);
+    AMREX_ASSERT_WITH_MESSAGE(m_bndrynorm != nullptr,
+                              "EBDataCollection::getBndryNormal: EBSupport::full is required");
     return *m_bndrynorm;
 }
 
+const MultiEBCutCells&
+EBDataCollection::getCutCells () const
+{
+    AMREX_ASSERT_WITH_MESSAGE(m_support >= EBSupport::cutcell,
+                              "EBDataCollection::getCutCells: EBSupport::cutcell or full is required");
+    if (m_support == EBSupport::full) {
+        std::call_once(m_cutcells_once, [this] () { buildCutCells(); });
+    }
+    return *m_cutcells;
+}
+
 }
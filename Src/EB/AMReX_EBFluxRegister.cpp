@@ -2,6 +2,7 @@
 #include <AMReX_EBFluxRegister.H>
 #include <AMReX_EBFluxRegister_C.H>
 #include <AMReX_EBFArrayBox.H>
+#include <AMReX_EBCutCells.H>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -68,6 +69,37 @@ EBFluxRegister::CrseAdd (const MFIter& mfi,
                          const FArrayBox& volfrac,
                          const std::array<FArrayBox const*, AMREX_SPACEDIM>& areafrac,
                          RunOn runon)
+{
+    GpuArray<Array4<Real const>,AMREX_SPACEDIM> a{AMREX_D_DECL(areafrac[0]->const_array(),
+                                                               areafrac[1]->const_array(),
+                                                               areafrac[2]->const_array())};
+    crseAdd_va(mfi, flux, dx, dt, volfrac, a, runon);
+}
+
+void
+EBFluxRegister::CrseAdd (const MFIter& mfi,
+                         const std::array<FArrayBox const*, AMREX_SPACEDIM>& flux,
+                         const Real* dx, Real dt,
+                         const FArrayBox& volfrac,
+                         const EBCutCells& cutcells, const EBCellFlagFab& ebflag,
+                         RunOn runon)
+{
+    BL_ASSERT(cutcells.box().isEmpty() || cutcells.box().contains(amrex::grow(mfi.tilebox(),1)));
+    const auto& cc = cutcells.const_array();
+    const auto& flag = ebflag.const_array();
+    GpuArray<EBCutCellsAreaFrac,AMREX_SPACEDIM> a;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        a[idim] = EBCutCellsAreaFrac{cc, flag, idim};
+    }
+    crseAdd_va(mfi, flux, dx, dt, volfrac, a, runon);
+}
+
+template <class A>
+void
+EBFluxRegister::crseAdd_va (const MFIter& mfi,
+                            const std::array<FArrayBox const*, AMREX_SPACEDIM>& flux,
+                            const Real* dx, Real dt, const FArrayBox& volfrac,
+                            const GpuArray<A,AMREX_SPACEDIM>& areafrac, RunOn runon)
 {
     BL_ASSERT(m_crse_data.nComp() == flux[0]->nComp());
 
@@ -86,9 +118,9 @@ EBFluxRegister::CrseAdd (const MFIter& mfi,
     AMREX_D_TERM(Array4<Real const> const& fx = flux[0]->const_array();,
                  Array4<Real const> const& fy = flux[1]->const_array();,
                  Array4<Real const> const& fz = flux[2]->const_array(););
-    AMREX_D_TERM(Array4<Real const> const& apx = areafrac[0]->const_array();,
-                 Array4<Real const> const& apy = areafrac[1]->const_array();,
-                 Array4<Real const> const& apz = areafrac[2]->const_array(););
+    AMREX_D_TERM(A const& apx = areafrac[0];,
+                 A const& apy = areafrac[1];,
+                 A const& apz = areafrac[2];);
     Array4<Real const> const& vfrac = volfrac.const_array();
 
     bool run_on_gpu = (runon == RunOn::Gpu && Gpu::inLaunchRegion());
@@ -109,6 +141,39 @@ EBFluxRegister::FineAdd (const MFIter& mfi,
                          const std::array<FArrayBox const*, AMREX_SPACEDIM>& areafrac,
                          const FArrayBox& dm,
                          RunOn runon)
+{
+    GpuArray<Array4<Real const>,AMREX_SPACEDIM> a{AMREX_D_DECL(areafrac[0]->const_array(),
+                                                               areafrac[1]->const_array(),
+                                                               areafrac[2]->const_array())};
+    fineAdd_va(mfi, a_flux, dx, dt, volfrac, a, dm, runon);
+}
+
+void
+EBFluxRegister::FineAdd (const MFIter& mfi,
+                         const std::array<FArrayBox const*, AMREX_SPACEDIM>& a_flux,
+                         const Real* dx, Real dt,
+                         const FArrayBox& volfrac,
+                         const EBCutCells& cutcells, const EBCellFlagFab& ebflag,
+                         const FArrayBox& dm,
+                         RunOn runon)
+{
+    BL_ASSERT(cutcells.box().isEmpty() || cutcells.box().contains(amrex::grow(mfi.tilebox(),1)));
+    const auto& cc = cutcells.const_array();
+    const auto& flag = ebflag.const_array();
+    GpuArray<EBCutCellsAreaFrac,AMREX_SPACEDIM> a;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        a[idim] = EBCutCellsAreaFrac{cc, flag, idim};
+    }
+    fineAdd_va(mfi, a_flux, dx, dt, volfrac, a, dm, runon);
+}
+
+template <class A>
+void
+EBFluxRegister::fineAdd_va (const MFIter& mfi,
+                            const std::array<FArrayBox const*, AMREX_SPACEDIM>& a_flux,
+                            const Real* dx, Real dt, const FArrayBox& volfrac,
+                            const GpuArray<A,AMREX_SPACEDIM>& areafrac,
+                            const FArrayBox& dm, RunOn runon)
 {
     BL_ASSERT(m_cfpatch.nComp() == a_flux[0]->nComp());
 
@@ -129,9 +194,9 @@ EBFluxRegister::FineAdd (const MFIter& mfi,
                  Array4<Real const> const& fz = a_flux[2]->const_array(););
 
     Array4<Real const> const& vfrac = volfrac.const_array();
-    AMREX_D_TERM(Array4<Real const> const& apx = areafrac[0]->const_array();,
-                 Array4<Real const> const& apy = areafrac[1]->const_array();,
-                 Array4<Real const> const& apz = areafrac[2]->const_array(););
+    AMREX_D_TERM(A const& apx = areafrac[0];,
+                 A const& apy = areafrac[1];,
+                 A const& apz = areafrac[2];);
 
     Dim3 ratio = m_ratio.dim3();
 
@@ -16,8 +16,153 @@
 
 #include <AMReX_EB2.H>
 
+#include <algorithm>
+#include <limits>
+
 namespace amrex {
 
+EBFacetIndex::EBFacetIndex(const Vector<Real> & facets) {
+
+    BL_PROFILE("EBFacetIndex::EBFacetIndex()")
+
+    const int n_facets = facets.size() / 6;
+
+    m_cent.resize(3 * n_facets);
+    for (int n = 0; n < n_facets; ++n) {
+        for (int d = 0; d < 3; ++d) m_cent[3*n + d] = facets[6*n + d];
+    }
+
+    m_id.resize(n_facets);
+    for (int n = 0; n < n_facets; ++n) m_id[n] = n;
+    m_split.assign(n_facets, 0);
+
+    build(0, n_facets);
+
+    // Gather the centres in tree order
+    Vector<Real> cent(3 * n_facets);
+    m_pos.resize(n_facets);
+    for (int k = 0; k < n_facets; ++k) {
+        for (int d = 0; d < 3; ++d) cent[3*k + d] = m_cent[3*m_id[k] + d];
+        m_pos[m_id[k]] = k;
+    }
+    m_cent.swap(cent);
+}
+
+
+
+void EBFacetIndex::build(int lo, int hi) {
+
+    if (hi - lo <= leaf_size) return;
+
+    // Split in the direction where the centres are spread the most
+    Real c_min[3], c_max[3];
+    for (int d = 0; d < 3; ++d) {
+        c_min[d] = std::numeric_limits<Real>::max();
+        c_max[d] = std::numeric_limits<Real>::lowest();
+    }
+    for (int k = lo; k < hi; ++k) {
+        for (int d = 0; d < 3; ++d) {
+            c_min[d] = std::min(c_min[d], m_cent[3*m_id[k] + d]);
+            c_max[d] = std::max(c_max[d], m_cent[3*m_id[k] + d]);
+        }
+    }
+    int dir = 0;
+    for (int d = 1; d < 3; ++d) {
+        if (c_max[d] - c_min[d] > c_max[dir] - c_min[dir]) dir = d;
+    }
+
+    const int mid = (lo + hi) / 2;
+    std::nth_element(m_id.begin() + lo, m_id.begin() + mid, m_id.begin() + hi,
+                     [&] (int a, int b) { return m_cent[3*a + dir] < m_cent[3*b + dir]; });
+    m_split[mid] = dir;
+
+    build(lo, mid);
+    build(mid + 1, hi);
+}
+
+
+
+void EBFacetIndex::test(int f, const Real * pos, Real & min_dist2, int & i_nearest) const {
+
+    const Real dx = pos[0] - m_cent[3*f];
+    const Real dy = pos[1] - m_cent[3*f + 1];
+    const Real dz = pos[2] - m_cent[3*f + 2];
+    const Real dist2 = dx*dx + dy*dy + dz*dz;
+
+    if (dist2 < min_dist2 || (dist2 == min_dist2 && m_id[f] < i_nearest)) {
+        min_dist2 = dist2;
+        i_nearest = m_id[f];
+    }
+}
+
+
+
+void EBFacetIndex::search(int lo, int hi, const Real * pos, Real & min_dist2, int & i_nearest) const {
+
+    if (hi - lo <= leaf_size) {
+        for (int f = lo; f < hi; ++f) test(f, pos, min_dist2, i_nearest);
+        return;
+    }
+
+    const int mid = (lo + hi) / 2;
+    const int dir = m_split[mid];
+    test(mid, pos, min_dist2, i_nearest);
+
+    // Facets in [lo, mid) are not above the split, those in [mid+1, hi) not
+    // below. Equal distances are searched too, for the tie-break.
+    const Real delta = pos[dir] - m_cent[3*mid + dir];
+    if (delta < 0) {
+        search(lo, mid, pos, min_dist2, i_nearest);
+        if (delta*delta <= min_dist2) search(mid + 1, hi, pos, min_dist2, i_nearest);
+    } else {
+        search(mid + 1, hi, pos, min_dist2, i_nearest);
+        if (delta*delta <= min_dist2) search(lo, mid, pos, min_dist2, i_nearest);
+    }
+}
+
+
+
+int EBFacetIndex::nearest(const Real * pos, Real max_dist, int guess) const {
+
+    // Facets at max_dist or more are never taken, and prune the search
+    Real min_dist2 = max_dist * max_dist;
+    int  i_nearest = -1;
+
+    if (guess >= 0) test(m_pos[guess], pos, min_dist2, i_nearest);
+
+    search(0, m_id.size(), pos, min_dist2, i_nearest);
+
+    return i_nearest;
+}
+
+
+
+void EBFacetIndex::nearest(const Box & bx, const RealVect & dx, Real max_dist,
+                           IArrayBox & nearest) const {
+
+    BL_PROFILE("EBFacetIndex::nearest()")
+
+    const auto near = nearest.array();
+    const Dim3 lo = amrex::lbound(bx);
+    const Dim3 hi = amrex::ubound(bx);
+
+    // Neighbouring nodes mostly have the same nearest facet
+    int guess = -1;
+    for (int k = lo.z; k <= hi.z; ++k) {
+        for (int j = lo.y; j <= hi.y; ++j) {
+            for (int i = lo.x; i <= hi.x; ++i) {
+                const Real pos[3] = {AMREX_D_PICK(i*dx[0], i*dx[0], i*dx[0]),
+                                     AMREX_D_PICK(0.,      j*dx[1], j*dx[1]),
+                                     AMREX_D_PICK(0.,      0.,      k*dx[2])};
+                guess = this->nearest(pos, max_dist, guess);
+                near(i, j, k) = guess;
+            }
+        }
+    }
+}
+
+
+
 LSFactory::LSFactory(int lev, int ls_ref, int eb_ref, int ls_pad, int eb_pad,
                      const BoxArray & ba, const Geometry & geom, const DistributionMapping & dm,
                      int a_eb_tile_size)
@@ -695,14 +840,34 @@ void LSFactory::fill_data (MultiFab & data, iMultiFab & valid,
 
 
         //_______________________________________________________________________
-        // Fill local level-set
+        // Level-set threshold
+        Real ls_threshold = min_dx * (eb_pad+1); //eb_pad => we know that any EB
+                                                 //is _at least_ eb_pad away from
+                                                 //the edge of the eb search box
+
+
+        //_______________________________________________________________________
+        // Fill local level-set, finding the nearest facets with an index of
+        // the facet list rather than by scanning it for every node
         if (len_facets > 0) {
 
-            amrex_eb_fill_levelset(BL_TO_FORTRAN_BOX(tile_box),
-                                   facets->dataPtr(), & len_facets,
-                                   BL_TO_FORTRAN_3D(v_tile),
-                                   BL_TO_FORTRAN_3D(ls_tile),
-                                   dx.dataPtr(), dx_eb.dataPtr() );
+            // Nodes whose nearest facet centre is further than the threshold
+            // plus a cell diagonal are at least the threshold away from the
+            // EB: they are not searched for, and left at -ls_threshold with
+            // eb_valid = 0 so that their sign comes from the implicit function
+            ls_tile.setVal( - ls_threshold, tile_box );
+            v_tile.setVal( 0, tile_box );
+
+            EBFacetIndex facet_index(* facets);
+            IArrayBox nearest(tile_box);
+            facet_index.nearest(tile_box, dx, ls_threshold + dx_eb.vectorLength(), nearest);
+
+            amrex_eb_fill_levelset_nearest(BL_TO_FORTRAN_BOX(tile_box),
+                                           facets->dataPtr(), & len_facets,
+                                           BL_TO_FORTRAN_3D(nearest),
+                                           BL_TO_FORTRAN_3D(v_tile),
+                                           BL_TO_FORTRAN_3D(ls_tile),
+                                           dx.dataPtr(), dx_eb.dataPtr() );
 
             region_tile.setVal(1);
         } else {
@@ -712,9 +877,6 @@ void LSFactory::fill_data (MultiFab & data, iMultiFab & valid,
 
         //_______________________________________________________________________
         // Threshold local level-set
-        Real ls_threshold = min_dx * (eb_pad+1); //eb_pad => we know that any EB
-                                                 //is _at least_ eb_pad away from
-                                                 //the edge of the eb search box
         amrex_eb_threshold_levelset(BL_TO_FORTRAN_BOX(tile_box), & ls_threshold,
                                     BL_TO_FORTRAN_3D(ls_tile));
 
@@ -69,10 +69,18 @@ MLCGSolver::solve (MultiFab&       sol,
                    Real            eps_rel,
                    Real            eps_abs)
 {
-    if (solver_type == Type::BiCGStab) {
+    nreductions = 0;
+    switch (solver_type) {
+    case Type::BiCGStab:
         return solve_bicgstab(sol,rhs,eps_rel,eps_abs);
-    } else {
+    case Type::CG:
         return solve_cg(sol,rhs,eps_rel,eps_abs);
+    case Type::PipelinedBiCGStab:
+        return solve_pipelined_bicgstab(sol,rhs,eps_rel,eps_abs);
+    case Type::PipelinedCG:
+        return solve_pipelined_cg(sol,rhs,eps_rel,eps_abs);
+    default:
+        return solve_sstep_cg(sol,rhs,eps_rel,eps_abs);
     }
 }
 
@@ -197,6 +205,7 @@ MLCGSolver::solve_bicgstab (MultiFab&       sol,
         BL_PROFILE_VAR("MLCGSolver::ParallelAllReduce", blp_par);
         ParallelAllReduce::Sum(tvals,2,Lp.BottomCommunicator());
         BL_PROFILE_VAR_STOP(blp_par);
+        ++nreductions;
 
         if ( tvals[0] )
 	{
@@ -391,13 +400,641 @@ MLCGSolver::solve_cg (MultiFab&       sol,
     return ret;
 }
 
+//
+// Pipelined BiCGStab (Cools & Vanroose).  With s = Ap, z = As, v = Az,
+// w = Ar and t = Aw carried by recurrences, each iteration needs two global
+// reductions, each of which is overlapped with one of the two
+// matrix-vector products.
+//
+int
+MLCGSolver::solve_pipelined_bicgstab (MultiFab&       sol,
+                                      const MultiFab& rhs,
+                                      Real            eps_rel,
+                                      Real            eps_abs)
+{
+    BL_PROFILE("MLCGSolver::pipelined_bicgstab");
+
+    const int ncomp = sol.nComp();
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    const auto& factory = sol.Factory();
+
+    // These are the inputs of Lp.apply and need ghost cells.
+    MultiFab r(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+    MultiFab w(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+    MultiFab z(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+    r.setVal(0.0);
+    w.setVal(0.0);
+    z.setVal(0.0);
+
+    MultiFab sorig(ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab rh   (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab p    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab s    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab q    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab y    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab t    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab v    (ba, dm, ncomp, nghost, MFInfo(), factory);
+
+    Lp.correctionResidual(amrlev, mglev, r, sol, rhs, MLLinOp::BCMode::Homogeneous);
+    Lp.normalize(amrlev, mglev, r);
+
+    MultiFab::Copy(sorig,sol,0,0,ncomp,nghost);
+    MultiFab::Copy(rh,   r,  0,0,ncomp,nghost);
+
+    sol.setVal(0);
+
+    Real rnorm = norm_inf(r);
+    const Real rnorm0 = rnorm;
+    const Real thresh = std::max(eps_rel*rnorm0, eps_abs);
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_PipelinedBiCGStab: Initial error (error0) =        " << rnorm0 << '\n';
+    }
+    int ret = 0, nit = 1;
+
+    if ( rnorm0 == 0 || rnorm0 < eps_abs )
+    {
+        if ( verbose > 0 )
+        {
+            amrex::Print() << "MLCGSolver_PipelinedBiCGStab: niter = 0,"
+                           << ", rnorm = " << rnorm
+                           << ", eps_abs = " << eps_abs << std::endl;
+        }
+        return ret;
+    }
+
+    Lp.apply(amrlev, mglev, w, r, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+    Lp.normalize(amrlev, mglev, w);
+
+    Real rvals[5] = { dotxy(rh,r,true), dotxy(rh,w,true), 0, 0, 0 };
+    startReduction(rvals,2);
+    Lp.apply(amrlev, mglev, t, w, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+    Lp.normalize(amrlev, mglev, t);
+    finishReduction();
+
+    Real rho = rvals[0];
+    Real alpha = 0, omega = 0;
+    if ( rvals[1] == 0 ) {
+        ret = 2;
+    } else {
+        alpha = rho/rvals[1];
+    }
+
+    for (; ret == 0 && nit <= maxiter; ++nit)
+    {
+        if ( nit == 1 )
+        {
+            MultiFab::Copy(p,r,0,0,ncomp,nghost);
+            MultiFab::Copy(s,w,0,0,ncomp,nghost);
+            MultiFab::Copy(z,t,0,0,ncomp,nghost);
+        }
+        else
+        {
+            const Real beta = (alpha/omega)*(rvals[0]/rho);
+            rho = rvals[0];
+            const Real rhTs = rvals[1] + beta*rvals[2] - beta*omega*rvals[3];
+            if ( rhTs == 0 )
+            {
+                ret = 2; break;
+            }
+            alpha = rho/rhTs;
+
+            sxay(p, p, -omega, s, nghost);
+            sxay(p, r,   beta, p, nghost);
+            sxay(s, s, -omega, z, nghost);
+            sxay(s, w,   beta, s, nghost);
+            sxay(z, z, -omega, v, nghost);
+            sxay(z, t,   beta, z, nghost);
+        }
+        sxay(q, r, -alpha, s, nghost);
+        sxay(y, w, -alpha, z, nghost);
+
+        Real qvals[3] = { dotxy(q,y,true), dotxy(y,y,true), dotxy(q,q,true) };
+        startReduction(qvals,3);
+        Lp.apply(amrlev, mglev, v, z, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        Lp.normalize(amrlev, mglev, v);
+        finishReduction();
+
+        sxay(sol, sol, alpha, p, nghost);
+
+        const bool half_converged = converged(q, std::sqrt(std::max(qvals[2],Real(0.))),
+                                              thresh, rnorm);
+
+        if ( verbose > 2 )
+        {
+            amrex::Print() << "MLCGSolver_PipelinedBiCGStab: Half Iter "
+                           << std::setw(11) << nit
+                           << " rel. err. "
+                           << rnorm/(rnorm0) << '\n';
+        }
+
+        if ( half_converged ) break;
+
+        if ( qvals[1] )
+        {
+            omega = qvals[0]/qvals[1];
+        }
+        else
+        {
+            ret = 3; break;
+        }
+        sxay(sol, sol, omega, q, nghost);
+        sxay(r, q, -omega, y, nghost);
+        sxay(t, t, -alpha, v, nghost);
+        sxay(w, y, -omega, t, nghost);
+
+        rvals[0] = dotxy(rh,r,true);
+        rvals[1] = dotxy(rh,w,true);
+        rvals[2] = dotxy(rh,s,true);
+        rvals[3] = dotxy(rh,z,true);
+        rvals[4] = dotxy(r,r,true);
+        startReduction(rvals,5);
+        Lp.apply(amrlev, mglev, t, w, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        Lp.normalize(amrlev, mglev, t);
+        finishReduction();
+
+        const bool full_converged = converged(r, std::sqrt(std::max(rvals[4],Real(0.))),
+                                              thresh, rnorm);
+
+        if ( verbose > 2 )
+        {
+            amrex::Print() << "MLCGSolver_PipelinedBiCGStab: Iteration "
+                           << std::setw(11) << nit
+                           << " rel. err. "
+                           << rnorm/(rnorm0) << '\n';
+        }
+
+        if ( full_converged ) break;
+
+        if ( omega == 0 )
+        {
+            ret = 4; break;
+        }
+        if ( rvals[0] == 0 )
+        {
+            ret = 1; break;
+        }
+    }
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_PipelinedBiCGStab: Final: Iteration "
+                       << std::setw(4) << nit
+                       << " rel. err. "
+                       << rnorm/(rnorm0) << '\n';
+        printReductions("MLCGSolver_PipelinedBiCGStab", std::min(nit,maxiter), 1+5*std::min(nit,maxiter));
+    }
+
+    if ( ret == 0 && rnorm >= thresh )
+    {
+        if ( verbose > 0 && ParallelDescriptor::IOProcessor() )
+            amrex::Warning("MLCGSolver_PipelinedBiCGStab:: failed to converge!");
+        ret = 8;
+    }
+
+    if ( ( ret == 0 || ret == 8 ) && (rnorm < rnorm0) )
+    {
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+    else
+    {
+        sol.setVal(0);
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+
+    return ret;
+}
+
+//
+// Pipelined CG (Ghysels & Vanroose).  The two inner products of an
+// iteration are reduced together while q = Aw is computed.
+//
+int
+MLCGSolver::solve_pipelined_cg (MultiFab&       sol,
+                                const MultiFab& rhs,
+                                Real            eps_rel,
+                                Real            eps_abs)
+{
+    BL_PROFILE("MLCGSolver::pipelined_cg");
+
+    const int ncomp = sol.nComp();
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    const auto& factory = sol.Factory();
+
+    // These are the inputs of Lp.apply and need ghost cells.
+    MultiFab r(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+    MultiFab w(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+    r.setVal(0.0);
+    w.setVal(0.0);
+
+    MultiFab sorig(ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab p    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab s    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab z    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab q    (ba, dm, ncomp, nghost, MFInfo(), factory);
+
+    MultiFab::Copy(sorig,sol,0,0,ncomp,nghost);
+
+    Lp.correctionResidual(amrlev, mglev, r, sol, rhs, MLLinOp::BCMode::Homogeneous);
+
+    sol.setVal(0);
+
+    Real       rnorm  = norm_inf(r);
+    const Real rnorm0 = rnorm;
+    const Real thresh = std::max(eps_rel*rnorm0, eps_abs);
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_PipelinedCG: Initial error (error0) :        " << rnorm0 << '\n';
+    }
+
+    int ret = 0;
+    int nit = 0;
+
+    if ( rnorm0 == 0 || rnorm0 < eps_abs )
+    {
+        if ( verbose > 0 ) {
+            amrex::Print() << "MLCGSolver_PipelinedCG: niter = 0,"
+                           << ", rnorm = " << rnorm
+                           << ", eps_abs = " << eps_abs << std::endl;
+        }
+        return ret;
+    }
+
+    Lp.apply(amrlev, mglev, w, r, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+
+    Real gamma_1 = 0, alpha = 0;
+
+    for (;;)
+    {
+        Real rvals[2] = { dotxy(r,r,true), dotxy(w,r,true) };
+        startReduction(rvals,2);
+        Lp.apply(amrlev, mglev, q, w, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        finishReduction();
+
+        const Real gamma = rvals[0];
+        const Real delta = rvals[1];
+
+        const bool done = nit > 0 && converged(r, std::sqrt(std::max(gamma,Real(0.))),
+                                               thresh, rnorm);
+
+        if ( verbose > 2 && nit > 0 )
+        {
+            amrex::Print() << "MLCGSolver_PipelinedCG:       Iteration"
+                           << std::setw(4) << nit
+                           << " rel. err. "
+                           << rnorm/(rnorm0) << '\n';
+        }
+
+        if ( done || nit == maxiter ) break;
+
+        ++nit;
+
+        Real beta;
+        if ( nit == 1 )
+        {
+            beta = 0;
+            if ( delta == 0 )
+            {
+                ret = 1; break;
+            }
+            alpha = gamma/delta;
+        }
+        else
+        {
+            beta = gamma/gamma_1;
+            const Real pw = delta - beta*gamma/alpha;
+            if ( gamma == 0 || pw == 0 )
+            {
+                ret = 1; break;
+            }
+            alpha = gamma/pw;
+        }
+
+        if ( verbose > 2 )
+        {
+            amrex::Print() << "MLCGSolver_PipelinedCG:"
+                           << " nit " << nit
+                           << " rho " << gamma
+                           << " alpha " << alpha << '\n';
+        }
+
+        if ( nit == 1 )
+        {
+            MultiFab::Copy(z,q,0,0,ncomp,nghost);
+            MultiFab::Copy(s,w,0,0,ncomp,nghost);
+            MultiFab::Copy(p,r,0,0,ncomp,nghost);
+        }
+        else
+        {
+            sxay(z, q, beta, z, nghost);
+            sxay(s, w, beta, s, nghost);
+            sxay(p, r, beta, p, nghost);
+        }
+        sxay(sol, sol, alpha, p, nghost);
+        sxay(  r,   r,-alpha, s, nghost);
+        sxay(  w,   w,-alpha, z, nghost);
+
+        gamma_1 = gamma;
+    }
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_PipelinedCG: Final Iteration"
+                       << std::setw(4) << nit
+                       << " rel. err. "
+                       << rnorm/(rnorm0) << '\n';
+        printReductions("MLCGSolver_PipelinedCG", nit, 1+3*nit);
+    }
+
+    if ( ret == 0 && rnorm >= thresh )
+    {
+        if ( verbose > 0 && ParallelDescriptor::IOProcessor() )
+            amrex::Warning("MLCGSolver_PipelinedCG: failed to converge!");
+        ret = 8;
+    }
+
+    if ( ( ret == 0 || ret == 8 ) && (rnorm < rnorm0) )
+    {
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+    else
+    {
+        sol.setVal(0);
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+
+    return ret;
+}
+
+//
+// s-step CG (communication-avoiding CG with a monomial basis).  Each outer
+// step builds Y = [p, Ap, ..., A^s p, r, Ar, ..., A^{s-1} r] and reduces
+// its Gram matrix G = Y^T Y in one message.  The following s CG iterations
+// are carried out on the coordinates of p, r and x in Y, with A acting as
+// the shift T on the coordinates, so that (u,v) = u'^T G v' and
+// Au = Y T u'.  For s > 1, the reduction of G overlaps the application of
+// A to A^s p and A^{s-1} r, from which Ap and Ar of the next outer step
+// follow without further communication.  Round-off grows with s; small
+// values (e.g., 2 to 5) are recommended.
+//
+int
+MLCGSolver::solve_sstep_cg (MultiFab&       sol,
+                            const MultiFab& rhs,
+                            Real            eps_rel,
+                            Real            eps_abs)
+{
+    BL_PROFILE("MLCGSolver::sstep_cg");
+
+    const int ncomp = sol.nComp();
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    const auto& factory = sol.Factory();
+
+    const int ns = std::max(sstep,1);
+    const int m = 2*ns+1;  // Y[0:ns] is the p block, Y[ns+1:2*ns] the r block
+
+    Vector<std::unique_ptr<MultiFab> > Y(m);
+    for (auto& mf : Y) {
+        mf.reset(new MultiFab(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory));
+        mf->setVal(0.0);
+    }
+    MultiFab& p = *Y[0];
+    MultiFab& r = *Y[ns+1];
+
+    MultiFab sorig(ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab rt   (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab pt   (ba, dm, ncomp, nghost, MFInfo(), factory);
+
+    // With s > 1, A applied to the last vector of each block is computed
+    // while the Gram matrix is being reduced.  The first power of the
+    // next p and r is then a combination of the basis and these two.
+    const bool overlap = ns > 1;
+    MultiFab Ap, Ar, apt, art;
+    if (overlap) {
+        Ap .define(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+        Ar .define(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+        apt.define(ba, dm, ncomp, nghost, MFInfo(), factory);
+        art.define(ba, dm, ncomp, nghost, MFInfo(), factory);
+    }
+    bool have_first_power = false;
+
+    MultiFab::Copy(sorig,sol,0,0,ncomp,nghost);
+
+    Lp.correctionResidual(amrlev, mglev, r, sol, rhs, MLLinOp::BCMode::Homogeneous);
+
+    sol.setVal(0);
+
+    Real       rnorm  = norm_inf(r);
+    const Real rnorm0 = rnorm;
+    const Real thresh = std::max(eps_rel*rnorm0, eps_abs);
+    const Real sqrtn = std::sqrt(static_cast<Real>(ba.numPts()*ncomp));
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_SStepCG: Initial error (error0) :        " << rnorm0 << '\n';
+    }
+
+    int ret = 0;
+    int nit = 0;
+
+    if ( rnorm0 == 0 || rnorm0 < eps_abs )
+    {
+        if ( verbose > 0 ) {
+            amrex::Print() << "MLCGSolver_SStepCG: niter = 0,"
+                           << ", rnorm = " << rnorm
+                           << ", eps_abs = " << eps_abs << std::endl;
+        }
+        return ret;
+    }
+
+    MultiFab::Copy(p,r,0,0,ncomp,nghost);
+
+    // Coordinates in Y, the Gram matrix (packed for the reduction) and T u.
+    Vector<Real> pc(m), rc(m), xc(m), tp(m), tr(m), G(m*m), gpack(m*(m+1)/2);
+
+    auto shift = [&] (const Vector<Real>& u, Vector<Real>& tu)
+    {
+        std::fill(tu.begin(), tu.end(), Real(0.));
+        for (int j = 0; j < ns; ++j) {
+            tu[j+1] += u[j];
+        }
+        for (int j = ns+1; j < m-1; ++j) {
+            tu[j+1] += u[j];
+        }
+    };
+
+    auto gdot = [&] (const Vector<Real>& u, const Vector<Real>& v) -> Real
+    {
+        Real d = 0;
+        for (int i = 0; i < m; ++i) {
+            Real gv = 0;
+            for (int j = 0; j < m; ++j) {
+                gv += G[i*m+j]*v[j];
+            }
+            d += u[i]*gv;
+        }
+        return d;
+    };
+
+    int pw_sign = 0;
+    bool done = false;
+    while (!done && ret == 0 && nit < maxiter)
+    {
+        // Matrix powers.  The first ones may be known already.
+        const int jfirst = have_first_power ? 1 : 0;
+        for (int j = jfirst; j < ns; ++j) {
+            Lp.apply(amrlev, mglev, *Y[j+1], *Y[j], MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        }
+        for (int j = ns+1+jfirst; j < m-1; ++j) {
+            Lp.apply(amrlev, mglev, *Y[j+1], *Y[j], MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        }
+
+        for (int i = 0, k = 0; i < m; ++i) {
+            for (int j = i; j < m; ++j) {
+                gpack[k++] = dotxy(*Y[i],*Y[j],true);
+            }
+        }
+        startReduction(gpack.data(), static_cast<int>(gpack.size()));
+        if (overlap) {
+            Lp.apply(amrlev, mglev, Ap, *Y[ns] , MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+            Lp.apply(amrlev, mglev, Ar, *Y[m-1], MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        }
+        finishReduction();
+        for (int i = 0, k = 0; i < m; ++i) {
+            for (int j = i; j < m; ++j, ++k) {
+                G[i*m+j] = G[j*m+i] = gpack[k];
+            }
+        }
+
+        std::fill(pc.begin(), pc.end(), Real(0.));
+        std::fill(rc.begin(), rc.end(), Real(0.));
+        std::fill(xc.begin(), xc.end(), Real(0.));
+        pc[0] = 1;
+        rc[ns+1] = 1;
+
+        Real rho = gdot(rc,rc);
+        Real rnorm2 = std::sqrt(std::max(rho,Real(0.)));
+        int j = 0;
+        for (; j < ns && nit < maxiter; ++j)
+        {
+            shift(pc, tp);
+            const Real pw = gdot(pc, tp);
+            if (pw_sign == 0) pw_sign = (pw < 0) ? -1 : 1;
+            if ( !(pw*pw_sign > 0) || !(rho > 0) )
+            {
+                // The operator may be negative definite, but its sign must
+                // not change.  If it appears to, the basis has lost
+                // accuracy: restart from the current iterate, or give up
+                // if no progress was made.
+                if (j == 0) ret = 1;
+                break;
+            }
+            const Real alpha = rho/pw;
+            ++nit;
+
+            for (int i = 0; i < m; ++i) {
+                xc[i] += alpha*pc[i];
+                rc[i] -= alpha*tp[i];
+            }
+            const Real rho_new = gdot(rc,rc);
+            const Real beta = rho_new/rho;
+            for (int i = 0; i < m; ++i) {
+                pc[i] = rc[i] + beta*pc[i];
+            }
+            rho = rho_new;
+            rnorm2 = std::sqrt(std::max(rho,Real(0.)));
+
+            if ( verbose > 2 )
+            {
+                amrex::Print() << "MLCGSolver_SStepCG:       Iteration"
+                               << std::setw(4) << nit
+                               << " rel. err. (2-norm estimate) "
+                               << rnorm2/(rnorm0) << '\n';
+            }
+
+            if (rnorm2 < thresh*sqrtn) { ++j; break; }
+        }
+
+        if (j > 0 && ret == 0)
+        {
+            // Back to the grid: x += Y xc, r = Y rc and p = Y pc.
+            rt.setVal(0.0);
+            pt.setVal(0.0);
+            for (int i = 0; i < m; ++i) {
+                if (xc[i] != 0) MultiFab::Saxpy(sol, xc[i], *Y[i], 0, 0, ncomp, nghost);
+                if (rc[i] != 0) MultiFab::Saxpy(rt,  rc[i], *Y[i], 0, 0, ncomp, nghost);
+                if (pc[i] != 0) MultiFab::Saxpy(pt,  pc[i], *Y[i], 0, 0, ncomp, nghost);
+            }
+            MultiFab::Copy(r,rt,0,0,ncomp,nghost);
+            MultiFab::Copy(p,pt,0,0,ncomp,nghost);
+
+            done = converged(r, rnorm2, thresh, rnorm);
+
+            if (overlap && !done)
+            {
+                // A Y u = Y T u, except for the last vector of each block.
+                shift(pc, tp);
+                shift(rc, tr);
+                apt.setVal(0.0);
+                art.setVal(0.0);
+                for (int i = 0; i < m; ++i) {
+                    if (tp[i] != 0) MultiFab::Saxpy(apt, tp[i], *Y[i], 0, 0, ncomp, nghost);
+                    if (tr[i] != 0) MultiFab::Saxpy(art, tr[i], *Y[i], 0, 0, ncomp, nghost);
+                }
+                MultiFab::Saxpy(apt, pc[ns] , Ap, 0, 0, ncomp, nghost);
+                MultiFab::Saxpy(apt, pc[m-1], Ar, 0, 0, ncomp, nghost);
+                MultiFab::Saxpy(art, rc[ns] , Ap, 0, 0, ncomp, nghost);
+                MultiFab::Saxpy(art, rc[m-1], Ar, 0, 0, ncomp, nghost);
+                MultiFab::Copy(*Y[1]   ,apt,0,0,ncomp,nghost);
+                MultiFab::Copy(*Y[ns+2],art,0,0,ncomp,nghost);
+                have_first_power = true;
+            }
+        }
+    }
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_SStepCG: Final Iteration"
+                       << std::setw(4) << nit
+                       << " rel. err. "
+                       << rnorm/(rnorm0) << '\n';
+        printReductions("MLCGSolver_SStepCG", nit, 1+3*nit);
+    }
+
+    if ( ret == 0 && rnorm >= thresh )
+    {
+        if ( verbose > 0 && ParallelDescriptor::IOProcessor() )
+            amrex::Warning("MLCGSolver_SStepCG: failed to converge!");
+        ret = 8;
+    }
+
+    if ( ( ret == 0 || ret == 8 ) && (rnorm < rnorm0) )
+    {
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+    else
+    {
+        sol.setVal(0);
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+
+    return ret;
+}
+
 Real
 MLCGSolver::dotxy (const MultiFab& r, const MultiFab& z, bool local)
 {
     BL_PROFILE_VAR_NS("MLCGSolver::ParallelAllReduce", blp_par);
     if (!local) { BL_PROFILE_VAR_START(blp_par); }
     Real result = Lp.xdoty(amrlev, mglev, r, z, local);
-    if (!local) { BL_PROFILE_VAR_STOP(blp_par); }
+    if (!local) { BL_PROFILE_VAR_STOP(blp_par); ++nreductions; }
     return result;
 }
 
@@ -412,9 +1049,62 @@ MLCGSolver::norm_inf (const MultiFab& res, bool local)
     if (!local) {
         BL_PROFILE("MLCGSolver::ParallelAllReduce");
         ParallelAllReduce::Max(result, Lp.BottomCommunicator());
+        ++nreductions;
     }
     return result;
 }
 
+void
+MLCGSolver::startReduction (Real* v, int n)
+{
+    ++nreductions;
+#ifdef BL_USE_MPI
+    MPI_Comm comm = Lp.BottomCommunicator();
+    if (ParallelDescriptor::NProcs(comm) > 1) {
+        BL_MPI_REQUIRE( MPI_Iallreduce(MPI_IN_PLACE, v, n,
+                                       ParallelDescriptor::Mpi_typemap<Real>::type(),
+                                       MPI_SUM, comm, &reduce_request) );
+    }
+#else
+    amrex::ignore_unused(v);
+    amrex::ignore_unused(n);
+#endif
+}
+
+void
+MLCGSolver::finishReduction ()
+{
+#ifdef BL_USE_MPI
+    if (reduce_request != MPI_REQUEST_NULL) {
+        BL_PROFILE("MLCGSolver::ParallelAllReduce");
+        BL_MPI_REQUIRE( MPI_Wait(&reduce_request, MPI_STATUS_IGNORE) );
+    }
+#endif
+}
+
+bool
+MLCGSolver::converged (const MultiFab& r, Real rnorm2, Real thresh, Real& rnorm)
+{
+    const Real sqrtn = std::sqrt(static_cast<Real>(r.boxArray().numPts()*r.nComp()));
+    if (rnorm2 < thresh) {
+        rnorm = rnorm2;
+        return true;
+    } else if (rnorm2 >= thresh*sqrtn) {
+        rnorm = rnorm2/sqrtn;
+        return false;
+    } else {
+        rnorm = norm_inf(r);
+        return rnorm < thresh;
+    }
+}
+
+void
+MLCGSolver::printReductions (const char* name, int niters, int nclassic) const
+{
+    amrex::Print() << name << ": " << nreductions << " global reductions in "
+                   << niters << " iterations, " << nclassic - nreductions
+                   << " fewer than the classic method\n";
+}
+
 
 }
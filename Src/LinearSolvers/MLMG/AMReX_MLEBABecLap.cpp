@@ -49,6 +49,8 @@ MLEBABecLap::define (const Vector<Geometry>& a_geom,
 
     Vector<FabFactory<FArrayBox> const*> _factory;
     for (auto x : a_factory) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(x == nullptr || x->getEBSupport() == EBSupport::full,
+                                         "MLEBABecLap: EBSupport::full is required");
         _factory.push_back(static_cast<FabFactory<FArrayBox> const*>(x));
     }
 
@@ -0,0 +1,320 @@
+
+#include <AMReX_MLGatherSolver.H>
+#include <AMReX_BoxIterator.H>
+#include <AMReX_ParallelReduce.H>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace amrex {
+
+namespace {
+
+    //
+    // Colors of the cells of one direction such that two cells with the same
+    // color are at least 2*reach+1 apart, also across a periodic boundary.
+    // With periodicity, the last (len % m) cells get colors of their own.
+    //
+    Vector<int> make_colors (int len, int reach, bool periodic, int& ncolors)
+    {
+        const int m = 2*reach+1;
+        Vector<int> color(len);
+        if (!periodic) {
+            for (int i = 0; i < len; ++i) color[i] = i % m;
+            ncolors = std::min(m, len);
+        } else if (len < m) {
+            for (int i = 0; i < len; ++i) color[i] = i;
+            ncolors = len;
+        } else {
+            const int nmain = len - len % m;
+            for (int i = 0; i < nmain; ++i) color[i] = i % m;
+            for (int i = nmain; i < len; ++i) color[i] = m + i - nmain;
+            ncolors = m + len - nmain;
+        }
+        return color;
+    }
+}
+
+MLGatherSolver::MLGatherSolver (MLLinOp& a_lp, const MultiFab& proto, int a_verbose)
+    : Lp(a_lp),
+      amrlev(0),
+      mglev(a_lp.NMGLevels(0)-1),
+      verbose(a_verbose),
+      m_ba(proto.boxArray()),
+      m_ncomp(proto.nComp())
+{
+    BL_PROFILE("MLGatherSolver::MLGatherSolver()");
+
+    AMREX_ALWAYS_ASSERT(Lp.isCellCentered());
+
+    m_offset.resize(m_ba.size()+1);
+    m_offset[0] = 0;
+    for (int i = 0, N = m_ba.size(); i < N; ++i) {
+        m_offset[i+1] = m_offset[i] + m_ba[i].numPts()*m_ncomp;
+    }
+    m_n = m_offset.back();
+
+    m_root = proto.DistributionMap()[0];
+    m_gather_dm.define(Vector<int>(m_ba.size(), m_root));
+
+    assemble(proto);
+    factorize();
+}
+
+long
+MLGatherSolver::index (int ibox, const IntVect& iv, int n) const
+{
+    const Box& bx = m_ba[ibox];
+    return m_offset[ibox] + n*bx.numPts() + bx.index(iv);
+}
+
+void
+MLGatherSolver::assemble (const MultiFab& proto)
+{
+    BL_PROFILE("MLGatherSolver::assemble()");
+
+    const Geometry& geom = Lp.Geom(amrlev, mglev);
+    const Box& domain = geom.Domain();
+    const int reach = std::max(1, Lp.getMaxOrder()-2);
+
+    Array<Vector<int>,AMREX_SPACEDIM> colors;
+    IntVect ncolors(1);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        colors[idim] = make_colors(domain.length(idim), reach, geom.isPeriodic(idim),
+                                   ncolors[idim]);
+    }
+    const Box colorbox(IntVect(0), ncolors-1);
+
+    const bool is_root = ParallelDescriptor::MyProc() == m_root;
+    if (is_root) {
+        m_lu.assign(m_n*m_n, 0.0);
+    }
+
+    const DistributionMapping& dm = proto.DistributionMap();
+    const auto& factory = proto.Factory();
+    MultiFab x (m_ba, dm, m_ncomp, proto.nGrow(), MFInfo(), factory);
+    MultiFab y (m_ba, dm, m_ncomp, 0, MFInfo(), factory);
+    MultiFab xh(m_ba, dm, m_ncomp, 0, MFInfo().SetArena(The_Pinned_Arena()));
+    MultiFab yg(m_ba, m_gather_dm, m_ncomp, 0, MFInfo().SetArena(The_Pinned_Arena()));
+
+    const IntVect dlo = domain.smallEnd();
+
+    for (int icomp = 0; icomp < m_ncomp; ++icomp)
+    {
+        for (BoxIterator cit(colorbox); cit.ok(); ++cit)
+        {
+            const IntVect c = cit();
+
+            // The probe is one on the cells of color c in component icomp.
+            xh.setVal(0.0);
+            for (MFIter mfi(xh); mfi.isValid(); ++mfi)
+            {
+                FArrayBox& fab = xh[mfi];
+                const Box& bx = mfi.validbox();
+                for (BoxIterator bit(bx); bit.ok(); ++bit)
+                {
+                    const IntVect iv = bit() - dlo;
+                    bool match = true;
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                        match = match && colors[idim][iv[idim]] == c[idim];
+                    }
+                    if (match) fab(bit(), icomp) = 1.0;
+                }
+            }
+            x.setVal(0.0);
+            MultiFab::Copy(x, xh, 0, 0, m_ncomp, 0);
+
+            Lp.apply(amrlev, mglev, y, x, MLLinOp::BCMode::Homogeneous,
+                     MLLinOp::StateMode::Correction);
+
+            yg.ParallelCopy(y);
+
+            // On the root, every nonzero of y in row (iv,n) is the entry of
+            // the only probed cell within reach of iv.
+            for (MFIter mfi(yg); mfi.isValid(); ++mfi)
+            {
+                const FArrayBox& fab = yg[mfi];
+                const int ibox = mfi.index();
+                const Box& bx = mfi.validbox();
+                for (int n = 0; n < m_ncomp; ++n)
+                {
+                    for (BoxIterator bit(bx); bit.ok(); ++bit)
+                    {
+                        const Real v = fab(bit(), n);
+                        if (v == 0.0) continue;
+
+                        IntVect jv;
+                        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+                        {
+                            const int len = domain.length(idim);
+                            const int i = bit()[idim] - dlo[idim];
+                            int found = -1;
+                            for (int d = -reach; d <= reach; ++d)
+                            {
+                                int j = i+d;
+                                if (geom.isPeriodic(idim)) {
+                                    j = ((j % len) + len) % len;
+                                } else if (j < 0 || j >= len) {
+                                    continue;
+                                }
+                                if (colors[idim][j] == c[idim] && j != found) {
+                                    AMREX_ALWAYS_ASSERT(found < 0);
+                                    found = j;
+                                }
+                            }
+                            if (found < 0) {
+                                amrex::Abort("MLGatherSolver: the stencil of the operator is too wide");
+                            }
+                            jv[idim] = found + dlo[idim];
+                        }
+
+                        const auto& isects = m_ba.intersections(Box(jv,jv));
+                        if (isects.empty()) {
+                            amrex::Abort("MLGatherSolver: the stencil of the operator is too wide");
+                        }
+                        const long row = index(ibox, bit(), n);
+                        const long col = index(isects[0].first, jv, icomp);
+                        m_lu[row*m_n+col] = v;
+                    }
+                }
+            }
+        }
+    }
+
+    if (is_root)
+    {
+        // Rows without entries (e.g., covered cells) become identity rows.
+        for (long row = 0; row < m_n; ++row) {
+            bool empty = true;
+            for (long col = 0; col < m_n && empty; ++col) {
+                empty = m_lu[row*m_n+col] == 0.0;
+            }
+            if (empty) m_lu[row*m_n+row] = 1.0;
+        }
+
+        // For a singular operator the right-hand side has been made
+        // solvable, so one equation per component is redundant and is
+        // replaced by fixing that unknown to zero.
+        if (Lp.isBottomSingular()) {
+            const int ilast = m_ba.size()-1;
+            const Box lastbx = m_ba[ilast];
+            for (int n = 0; n < m_ncomp; ++n) {
+                const long row = index(ilast, lastbx.bigEnd(), n);
+                std::fill(m_lu.begin()+row*m_n, m_lu.begin()+(row+1)*m_n, 0.0);
+                m_lu[row*m_n+row] = 1.0;
+            }
+        }
+    }
+}
+
+void
+MLGatherSolver::factorize ()
+{
+    BL_PROFILE("MLGatherSolver::factorize()");
+
+    int ok = 1;
+    if (ParallelDescriptor::MyProc() == m_root)
+    {
+        // LU with partial pivoting, L and U in place
+        const long n = m_n;
+        Real* a = m_lu.data();
+        m_piv.resize(n);
+        Real amax = 0.0;
+        for (long i = 0; i < n*n; ++i) {
+            amax = std::max(amax, std::abs(a[i]));
+        }
+        const Real small = amax * n * std::numeric_limits<Real>::epsilon();
+        for (long k = 0; k < n && ok; ++k)
+        {
+            long p = k;
+            for (long i = k+1; i < n; ++i) {
+                if (std::abs(a[i*n+k]) > std::abs(a[p*n+k])) p = i;
+            }
+            m_piv[k] = p;
+            if (!(std::abs(a[p*n+k]) > small)) {
+                ok = 0;
+                break;
+            }
+            if (p != k) {
+                std::swap_ranges(a+k*n, a+(k+1)*n, a+p*n);
+            }
+            const Real rpiv = 1.0/a[k*n+k];
+            for (long i = k+1; i < n; ++i)
+            {
+                Real* ai = a+i*n;
+                if (ai[k] == 0.0) continue;
+                ai[k] *= rpiv;
+                const Real l = ai[k];
+                const Real* ak = a+k*n;
+                for (long j = k+1; j < n; ++j) {
+                    ai[j] -= l*ak[j];
+                }
+            }
+        }
+    }
+
+    ParallelAllReduce::Min(ok, ParallelContext::CommunicatorSub());
+    m_ok = ok;
+
+    if (verbose > 0) {
+        amrex::Print() << "MLGatherSolver: " << m_n << " unknowns on rank " << m_root
+                       << (m_ok ? "" : ", singular matrix") << "\n";
+    }
+}
+
+void
+MLGatherSolver::solve (MultiFab& x, const MultiFab& b)
+{
+    BL_PROFILE("MLGatherSolver::solve()");
+
+    AMREX_ASSERT(m_ok);
+
+    MultiFab g(m_ba, m_gather_dm, m_ncomp, 0, MFInfo().SetArena(The_Pinned_Arena()));
+    g.ParallelCopy(b);
+
+    if (ParallelDescriptor::MyProc() == m_root)
+    {
+        Vector<Real> v(m_n);
+        for (MFIter mfi(g); mfi.isValid(); ++mfi)
+        {
+            const long nbx = mfi.validbox().numPts()*m_ncomp;
+            std::copy(g[mfi].dataPtr(), g[mfi].dataPtr()+nbx, v.begin()+m_offset[mfi.index()]);
+        }
+
+        if (Lp.isBottomSingular()) {
+            const int ilast = m_ba.size()-1;
+            const Box lastbx = m_ba[ilast];
+            for (int n = 0; n < m_ncomp; ++n) {
+                v[index(ilast, lastbx.bigEnd(), n)] = 0.0;
+            }
+        }
+
+        const long n = m_n;
+        const Real* a = m_lu.data();
+        for (long k = 0; k < n; ++k) {
+            std::swap(v[k], v[m_piv[k]]);
+        }
+        for (long i = 1; i < n; ++i) {
+            Real s = v[i];
+            for (long j = 0; j < i; ++j) s -= a[i*n+j]*v[j];
+            v[i] = s;
+        }
+        for (long i = n-1; i >= 0; --i) {
+            Real s = v[i];
+            for (long j = i+1; j < n; ++j) s -= a[i*n+j]*v[j];
+            v[i] = s/a[i*n+i];
+        }
+
+        for (MFIter mfi(g); mfi.isValid(); ++mfi)
+        {
+            const long nbx = mfi.validbox().numPts()*m_ncomp;
+            std::copy(v.begin()+m_offset[mfi.index()], v.begin()+m_offset[mfi.index()]+nbx,
+                      g[mfi].dataPtr());
+        }
+    }
+
+    x.ParallelCopy(g);
+}
+
+}
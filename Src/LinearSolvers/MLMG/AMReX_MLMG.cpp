@@ -922,12 +922,25 @@ MLMG::actualBottomSolve ()
         {
             bottomSolveWithPETSc(x, *bottom_b);
         }
+        else if (bottom_solver == BottomSolver::gather &&
+                 bottomSolveWithGather(x, *bottom_b))
+        {
+            for (int i = 0; i < nub; ++i) {
+                linop.smooth(amrlev, mglev, x, b);
+            }
+        }
         else
         {
             MLCGSolver::Type cg_type;
             if (bottom_solver == BottomSolver::cg ||
                 bottom_solver == BottomSolver::cgbicg) {
                 cg_type = MLCGSolver::Type::CG;
+            } else if (bottom_solver == BottomSolver::pipelined_bicgstab) {
+                cg_type = MLCGSolver::Type::PipelinedBiCGStab;
+            } else if (bottom_solver == BottomSolver::pipelined_cg) {
+                cg_type = MLCGSolver::Type::PipelinedCG;
+            } else if (bottom_solver == BottomSolver::sstep_cg) {
+                cg_type = MLCGSolver::Type::SStepCG;
             } else {
                 cg_type = MLCGSolver::Type::BiCGStab;
             }
@@ -973,6 +986,7 @@ MLMG::bottomSolveWithCG (MultiFab& x, const MultiFab& b, MLCGSolver::Type type)
     cg_solver.setSolver(type);
     cg_solver.setVerbose(bottom_verbose);
     cg_solver.setMaxIter(bottom_maxiter);
+    cg_solver.setSStep(bottom_sstep);
     if (cf_strategy == CFStrategy::ghostnodes) cg_solver.setNGhost(linop.getNGrow());
 
     int ret = cg_solver.solve(x, b, bottom_reltol, bottom_abstol);
@@ -982,6 +996,28 @@ MLMG::bottomSolveWithCG (MultiFab& x, const MultiFab& b, MLCGSolver::Type type)
     return ret;
 }
 
+bool
+MLMG::bottomSolveWithGather (MultiFab& x, const MultiFab& b)
+{
+    // Fall back to bicgstab if the bottom level is too large or the
+    // operator is not supported.
+    if (!linop.isCellCentered() || cf_strategy == CFStrategy::ghostnodes ||
+        x.boxArray().numPts()*x.nComp() > bottom_gather_max_size) {
+        return false;
+    }
+
+    if (gather_solver == nullptr) {
+        gather_solver.reset(new MLGatherSolver(linop, x, bottom_verbose));
+    }
+
+    if (gather_solver->ok()) {
+        gather_solver->solve(x, b);
+        return true;
+    } else {
+        return false;
+    }
+}
+
 // Compute single-level masked inf-norm of Residual (res).
 Real
 MLMG::ResNormInf (int alev, bool local)
@@ -1110,6 +1146,8 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
         linop.update();
     }
 
+    gather_solver.reset();
+
 #ifdef AMREX_USE_HYPRE
     hypre_solver.reset();
     hypre_bndry.reset();
@@ -367,6 +367,18 @@ NodalProjector::setup ()
     {
         m_solver->setBottomSolver(MLMG::BottomSolver::cgbicg);
     }
+    else if (m_bottom_solver_type == "pipelined_bicg")
+    {
+        m_solver->setBottomSolver(MLMG::BottomSolver::pipelined_bicgstab);
+    }
+    else if (m_bottom_solver_type == "pipelined_cg")
+    {
+        m_solver->setBottomSolver(MLMG::BottomSolver::pipelined_cg);
+    }
+    else if (m_bottom_solver_type == "sstep_cg")
+    {
+        m_solver->setBottomSolver(MLMG::BottomSolver::sstep_cg);
+    }
     else if (m_bottom_solver_type == "hypre")
     {
 #ifdef AMREX_USE_HYPRE
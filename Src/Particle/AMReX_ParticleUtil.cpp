@@ -1,4 +1,6 @@
 #include <AMReX_ParticleUtil.H>
+#include <AMReX_NFiles.H>
+#include <AMReX_Utility.H>
 
 namespace amrex
 {
@@ -65,4 +67,101 @@ Vector<int> computeNeighborProcs (const ParGDBBase* a_gdb, int ngrow)
     return neighbor_procs;
 }
 
+void
+ParticleCheckpointHeader::writeOn (std::ostream& os) const
+{
+    os << version << '\n';
+    os << dim << '\n';
+    os << real_comp_names.size() << '\n';
+    for (const auto& name : real_comp_names) os << name << '\n';
+    os << int_comp_names.size() << '\n';
+    for (const auto& name : int_comp_names) os << name << '\n';
+    os << is_checkpoint << '\n';
+    os << nparticles << '\n';
+    os << maxnextid << '\n';
+    os << finest_level << '\n';
+    for (int n : ngrids) os << n << '\n';
+}
+
+void
+ParticleCheckpointHeader::readFrom (std::istream& is, const char* caller)
+{
+    // What do our version strings mean?
+    // "Version_One_Dot_Zero" -- hard-wired to write out in double precision.
+    // "Version_One_Dot_One" -- can write out either as either single or double precision.
+    // Appended to the latter version string are either "_single" or "_double" to
+    // indicate how the particles were written.
+    // "Version_Two_Dot_Zero" -- this is the AMReX particle file format
+    how.clear();
+    if (version.find("Version_One_Dot_Zero") != std::string::npos) {
+        how = "double";
+    }
+    else if (version.find("Aggregated") == std::string::npos and
+             (version.find("Version_One_Dot_One")  != std::string::npos or
+              version.find("Version_Two_Dot_Zero") != std::string::npos)) {
+        if (version.find("_single") != std::string::npos) {
+            how = "single";
+        }
+        else if (version.find("_double") != std::string::npos) {
+            how = "double";
+        }
+    }
+    if (how.empty()) {
+        std::string msg(caller);
+        msg += ": unsupported version string: ";
+        msg += version;
+        amrex::Abort(msg.c_str());
+    }
+
+    is >> dim;
+
+    int nr;
+    is >> nr;
+    real_comp_names.resize(nr);
+    for (auto& name : real_comp_names) is >> name;
+
+    int ni;
+    is >> ni;
+    int_comp_names.resize(ni);
+    for (auto& name : int_comp_names) is >> name;
+
+    is >> is_checkpoint;
+    is >> nparticles;
+    AMREX_ASSERT(nparticles >= 0);
+    is >> maxnextid;
+    AMREX_ASSERT(maxnextid > 0);
+    is >> finest_level;
+    AMREX_ASSERT(finest_level >= 0);
+
+    ngrids.resize(finest_level+1);
+    for (auto& n : ngrids) {
+        is >> n;
+        AMREX_ASSERT(n > 0);
+    }
+}
+
+void writeParticleGridLocations (std::ostream& HdrFile, const Vector<int>& which,
+                                 const Vector<int>& count, const Vector<long>& where,
+                                 int nOutFiles, const std::string& filePrefix, bool unlink)
+{
+    for (int j = 0, N = which.size(); j < N; j++) {
+        HdrFile << which[j] << ' ' << count[j] << ' ' << where[j] << '\n';
+    }
+
+    if (unlink)
+    {
+        // Unlink any zero-length data files.
+        Vector<long> cnt(nOutFiles,0);
+        for (int i = 0, N = count.size(); i < N; i++) {
+            cnt[which[i]] += count[i];
+        }
+        for (int i = 0; i < nOutFiles; i++) {
+            if (cnt[i] == 0) {
+                std::string FullFileName = NFilesIter::FileName(i, filePrefix);
+                amrex::UnlinkFile(FullFileName.c_str());
+            }
+        }
+    }
+}
+
 }
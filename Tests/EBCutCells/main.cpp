@@ -0,0 +1,171 @@
+//
+// Checks the cut cells of an EBSupport::full factory against its dense
+// MultiCutFabs: every cut cell of the grown boxes has a record holding the
+// same data, and EBCutCellsAreaFrac gives the dense area fraction on all
+// faces of the tile boxes grown by one cell.  The cut cells of an
+// EBSupport::cutcell factory must be the same.
+//
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_MultiCutFab.H>
+#include <AMReX_EBCutCells.H>
+
+using namespace amrex;
+
+namespace {
+
+void check (bool ok, const std::string& what)
+{
+    if (!ok) amrex::Abort("EBCutCells failed: " + what);
+}
+
+bool sameData (EBCutCellData const& a, EBCutCellData const& b)
+{
+    bool r = a.volfrac == b.volfrac && a.bndryarea == b.bndryarea;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        r = r && a.centroid[idim] == b.centroid[idim]
+              && a.bndrycent[idim] == b.bndrycent[idim]
+              && a.bndrynorm[idim] == b.bndrynorm[idim];
+    }
+    for (int iface = 0; iface < 2*AMREX_SPACEDIM; ++iface) {
+        r = r && a.areafrac[iface] == b.areafrac[iface];
+        for (int n = 0; n < AMREX_SPACEDIM-1; ++n) {
+            r = r && a.facecent[iface][n] == b.facecent[iface][n];
+        }
+    }
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        {
+            ParmParse pp("eb2");
+            pp.add("geom_type", std::string("sphere"));
+            pp.addarr("sphere_center", std::vector<Real>{AMREX_D_DECL(0.5,0.5,0.5)});
+            pp.add("sphere_radius", 0.3);
+            pp.add("sphere_has_fluid_inside", 0);
+        }
+
+        const int n_cell = 32;
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)), &rb, 0, is_periodic.data());
+        BoxArray ba(geom.Domain());
+        ba.maxSize(8);
+        DistributionMapping dm(ba);
+
+        EB2::Build(geom, 0, 0);
+
+        const Vector<int> ng{2,2,2};
+        auto full = makeEBFabFactory(geom, ba, dm, ng, EBSupport::full);
+        auto sparse = makeEBFabFactory(geom, ba, dm, ng, EBSupport::cutcell);
+
+        const auto& flags = full->getMultiEBCellFlagFab();
+        const MultiFab& volfrac = full->getVolFrac();
+        const MultiCutFab& centroid = full->getCentroid();
+        const MultiCutFab& bndryarea = full->getBndryArea();
+        const MultiCutFab& bndrycent = full->getBndryCent();
+        const MultiCutFab& bndrynorm = full->getBndryNormal();
+        const auto areafrac = full->getAreaFrac();
+        const auto facecent = full->getFaceCent();
+        const MultiEBCutCells& cutcells = full->getCutCells();
+        const MultiEBCutCells& sparse_cutcells = sparse->getCutCells();
+
+        const int ngrow = cutcells.nGrow();
+        check(ngrow == std::min(ng[1],ng[2]), "nGrow");
+
+        Long ncut = 0;
+        for (MFIter mfi(flags); mfi.isValid(); ++mfi)
+        {
+            const EBCutCells& cc = cutcells[mfi];
+            const auto cca = cc.const_array();
+            const auto scca = sparse_cutcells.const_array(mfi);
+
+            if (flags[mfi].getType() != FabType::singlevalued) {
+                check(cc.size() == 0 && scca.size() == 0, "cut cells of a box that is not cut");
+                continue;
+            }
+
+            const Box& bx = mfi.growntilebox(ngrow);
+            check(cc.box() == bx && sparse_cutcells[mfi].box() == bx, "box of the cut cells");
+            check(scca.size() == cca.size(), "number of cut cells with EBSupport::cutcell");
+
+            const auto flag = flags.const_array(mfi);
+            const auto vfrac = volfrac.const_array(mfi);
+            const auto cent = centroid.const_array(mfi);
+            const auto barea = bndryarea.const_array(mfi);
+            const auto bcent = bndrycent.const_array(mfi);
+            const auto bnorm = bndrynorm.const_array(mfi);
+            Array<Array4<Real const>,AMREX_SPACEDIM> afrac, fcent;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                afrac[idim] = areafrac[idim]->const_array(mfi);
+                fcent[idim] = facecent[idim]->const_array(mfi);
+            }
+
+            int nfound = 0;
+            amrex::LoopOnCpu(bx, [&] (int i, int j, int k)
+            {
+                EBCutCellData const* d = cca.find(i,j,k);
+                if (!flag(i,j,k).isSingleValued()) {
+                    check(d == nullptr, "record of a cell that is not cut");
+                    return;
+                }
+                check(d != nullptr, "cut cell without a record");
+                const int n = d - cca.data;
+                check(cca.cells[n] == IntVect(AMREX_D_DECL(i,j,k)), "cell of a record");
+                check(sameData(*d, scca.data[n]) && scca.cells[n] == cca.cells[n],
+                      "record with EBSupport::cutcell");
+                ++nfound;
+
+                bool ok = d->volfrac == vfrac(i,j,k) && d->bndryarea == barea(i,j,k);
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    const int ih = i + (idim == 0);
+                    const int jh = j + (idim == 1);
+                    const int kh = k + (idim == 2);
+                    ok = ok && d->centroid[idim] == cent(i,j,k,idim)
+                            && d->bndrycent[idim] == bcent(i,j,k,idim)
+                            && d->bndrynorm[idim] == bnorm(i,j,k,idim)
+                            && d->areafrac[2*idim  ] == afrac[idim](i ,j ,k )
+                            && d->areafrac[2*idim+1] == afrac[idim](ih,jh,kh);
+                    for (int n2 = 0; n2 < AMREX_SPACEDIM-1; ++n2) {
+                        ok = ok && d->facecent[2*idim  ][n2] == fcent[idim](i ,j ,k ,n2)
+                                && d->facecent[2*idim+1][n2] == fcent[idim](ih,jh,kh,n2);
+                    }
+                }
+                check(ok, "data of a record");
+            });
+            check(nfound == cca.size(), "number of cut cells");
+            ncut += nfound;
+        }
+
+        ParallelDescriptor::ReduceLongSum(ncut);
+        check(ncut > 0, "no cut cells");
+
+        // Area fractions from the cut cells on the faces of the grown tiles
+        for (MFIter mfi(flags, MFItInfo().EnableTiling(IntVect(4))); mfi.isValid(); ++mfi)
+        {
+            if (flags[mfi].getType() != FabType::singlevalued) continue;
+
+            const Box& gbx = amrex::grow(mfi.tilebox(), 1);
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+            {
+                const EBCutCellsAreaFrac a{cutcells.const_array(mfi), flags.const_array(mfi), idim};
+                const auto dense = areafrac[idim]->const_array(mfi);
+                amrex::LoopOnCpu(amrex::surroundingNodes(gbx,idim), [&] (int i, int j, int k)
+                {
+                    check(a(i,j,k) == dense(i,j,k), "EBCutCellsAreaFrac");
+                });
+            }
+        }
+
+        amrex::Print() << "EBCutCells passed with " << ncut << " cut cells\n";
+    }
+    amrex::Finalize();
+}
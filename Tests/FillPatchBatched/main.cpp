@@ -0,0 +1,191 @@
+//
+// Compares the batched FillPatchTwoLevels with one call per item.  The
+// items fill two destinations from coarse data at two different pairs of
+// times, so the coarse patches are filled with one copy per run of items,
+// and use a pair of interpolation hooks that only cancel if they are given
+// the right components of the shared coarse patches.  The reference of
+// each item is computed with an empty FillPatch cache.  The same fills are
+// then repeated with calls of different ncomp in between, and the coarse
+// patches kept in the cache must grow once and then be reused.
+//
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_FillPatchUtil.H>
+#include <AMReX_PhysBCFunct.H>
+#include <AMReX_Interpolater.H>
+
+using namespace amrex;
+
+namespace {
+
+void check (bool ok, const std::string& what)
+{
+    if (!ok) amrex::Abort("FillPatchBatched failed: " + what);
+}
+
+// Adds shift*(n+1) to component icomp+n.  A pre hook with shift s and a
+// post hook with -s cancel for a linear interpolater.
+class ShiftHook final
+    : public InterpHook
+{
+public:
+    explicit ShiftHook (Real shift) : m_shift(shift) {}
+
+    virtual void operator() (FArrayBox& fab, const Box& bx, int icomp, int ncomp) const final
+    {
+        const auto a = fab.array();
+        const Real shift = m_shift;
+        amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            a(i,j,k,icomp+n) += shift*(n+1);
+        });
+    }
+
+private:
+    Real m_shift;
+};
+
+void fillCoarse (MultiFab& mf, Real a, Real b)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const auto d = mf.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), mf.nComp(), [=] (int i, int j, int k, int n) {
+            d(i,j,k,n) = std::sin(a*i + b*j + 0.2*k + n) + 0.01*n*i;
+        });
+    }
+}
+
+// The coarse patches kept by the only FillPatch cache entry
+const MultiFab* keptPatch ()
+{
+    check(FabArrayBase::m_TheFillPatchCache.size() == 1, "expected one FillPatch cache entry");
+    return FabArrayBase::m_TheFillPatchCache.begin()->second->mf_crse_patch.get();
+}
+
+Real maxDiff (const MultiFab& a, const MultiFab& b)
+{
+    MultiFab d(a.boxArray(), a.DistributionMap(), a.nComp(), a.nGrow());
+    MultiFab::Copy(d, a, 0, 0, a.nComp(), a.nGrow());
+    MultiFab::Subtract(d, b, 0, 0, a.nComp(), a.nGrow());
+    Real r = 0.0;
+    for (int n = 0; n < a.nComp(); ++n) {
+        r = std::max(r, d.norm0(n, a.nGrow()));
+    }
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        const Box cdomain(IntVect(0), IntVect(31));
+        const IntVect ratio(2);
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+        Geometry cgeom(cdomain, &rb, 0, is_periodic.data());
+        Geometry fgeom(amrex::refine(cdomain,ratio), &rb, 0, is_periodic.data());
+
+        BoxArray cba(cdomain);
+        cba.maxSize(16);
+        BoxArray fba(Box(IntVect(16), IntVect(47)));
+        fba.maxSize(8);
+        DistributionMapping cdm(cba), fdm(fba);
+
+        // Two pairs of coarse time levels and one fine time level
+        const int nc = 5;
+        MultiFab c0(cba,cdm,nc,0), c1(cba,cdm,nc,0), d0(cba,cdm,nc,0), d1(cba,cdm,nc,0);
+        MultiFab f0(fba,fdm,nc,0);
+        fillCoarse(c0, 0.3, 0.1);
+        fillCoarse(c1, 0.2, 0.3);
+        fillCoarse(d0, 0.1, 0.2);
+        fillCoarse(d1, 0.4, 0.1);
+        f0.setVal(3.0);
+
+        const Vector<MultiFab*> cmf{&c0,&c1}, dmf{&d0,&d1}, fmf{&f0};
+        const Vector<Real> ct{0.0,1.0}, dt{0.25,0.75}, ft{0.6};
+        const Real time = 0.6;
+
+        Vector<BCRec> bcs(nc, BCRec(AMREX_D_DECL(BCType::int_dir,BCType::int_dir,BCType::int_dir),
+                                    AMREX_D_DECL(BCType::int_dir,BCType::int_dir,BCType::int_dir)));
+        PhysBCFunctNoOp nobc;
+        ShiftHook pre(10.0), post(-10.0);
+
+        // Destinations a (5 components) and b (2 components), with the same layout
+        const int ng = 3;
+        auto makeItems = [&] (MultiFab& a, MultiFab& b) -> Vector<FillPatchItem>
+        {
+            Vector<FillPatchItem> items;
+            items.emplace_back(a,cmf,ct,fmf,ft,0,0,1,nobc,0,nobc,0,&cell_cons_interp,bcs,0,&pre,&post);
+            items.emplace_back(a,dmf,dt,fmf,ft,1,1,2,nobc,0,nobc,0,&cell_cons_interp,bcs,1,&pre,&post);
+            items.emplace_back(a,cmf,ct,fmf,ft,3,3,2,nobc,0,nobc,0,&cell_cons_interp,bcs,3,&pre,&post);
+            items.emplace_back(b,dmf,dt,fmf,ft,2,0,2,nobc,0,nobc,0,&cell_cons_interp,bcs,2,&pre,&post);
+            return items;
+        };
+        const int ncomp_tot = 7;
+
+        auto fillOne = [&] (const FillPatchItem& item)
+        {
+            FillPatchTwoLevels(*item.mf, time, item.cmf, item.ct, item.fmf, item.ft,
+                               item.scomp, item.dcomp, item.ncomp, cgeom, fgeom,
+                               *item.cbc, item.cbccomp, *item.fbc, item.fbccomp, ratio,
+                               item.mapper, *item.bcs, item.bcscomp,
+                               *item.pre_interp, *item.post_interp);
+        };
+
+        // Reference: one call per item, each with an empty cache
+        MultiFab aref(fba,fdm,nc,ng), bref(fba,fdm,2,ng);
+        aref.setVal(-1.0);
+        bref.setVal(-1.0);
+        for (const auto& item : makeItems(aref,bref)) {
+            FabArrayBase::flushFPinfoCache();
+            fillOne(item);
+            check(keptPatch()->nComp() == item.ncomp, "the kept patches have the item's ncomp");
+        }
+
+        // A call with one component leaves patches of one component.
+        FabArrayBase::flushFPinfoCache();
+        {
+            MultiFab a(fba,fdm,nc,ng), b(fba,fdm,2,ng);
+            a.setVal(-1.0);
+            b.setVal(-1.0);
+            fillOne(makeItems(a,b)[0]);
+        }
+        check(keptPatch()->nComp() == 1, "the kept patches have one component");
+
+        // The batched call grows them to all the components of the group, ...
+        const MultiFab* patch = nullptr;
+        for (int iter = 0; iter < 2; ++iter)
+        {
+            MultiFab a(fba,fdm,nc,ng), b(fba,fdm,2,ng);
+            a.setVal(-1.0);
+            b.setVal(-1.0);
+            FillPatchTwoLevels(makeItems(a,b), time, cgeom, fgeom, ratio);
+            check(maxDiff(a,aref) <= 1.e-12 && maxDiff(b,bref) <= 1.e-12,
+                  "batched fill differs from single fills");
+            check(keptPatch()->nComp() == ncomp_tot, "the kept patches have all components");
+            if (patch == nullptr) {
+                patch = keptPatch();
+            } else {
+                check(keptPatch() == patch, "the kept patches are reused by the batched fill");
+            }
+
+            // ... which calls with fewer components reuse.  The patches
+            // hold the data of the previous call in the other components.
+            MultiFab a1(fba,fdm,nc,ng), b1(fba,fdm,2,ng);
+            a1.setVal(-1.0);
+            b1.setVal(-1.0);
+            for (const auto& item : makeItems(a1,b1)) {
+                fillOne(item);
+                check(keptPatch() == patch, "the kept patches are reused by a single fill");
+            }
+            check(maxDiff(a1,aref) <= 1.e-12 && maxDiff(b1,bref) <= 1.e-12,
+                  "single fills with reused patches differ");
+        }
+
+        amrex::Print() << "FillPatchBatched passed\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,293 @@
+//
+// Times CellQuadratic, CellConservativeProtected::protect and
+// CellConservativeQuartic against the Fortran routines they used to call,
+// and reports the largest difference between the two results.
+//
+
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_Interpolater.H>
+#include <AMReX_INTERP_F.H>
+#include <AMReX_Utility.H>
+
+#include <iomanip>
+
+using namespace amrex;
+
+namespace {
+
+#if (AMREX_SPACEDIM == 2)
+void fortran_quadratic (const FArrayBox& crse, FArrayBox& fine, int ncomp, const Box& fine_region,
+                        const IntVect& ratio, const Geometry& crse_geom, const Geometry& fine_geom,
+                        Vector<BCRec> const& bcr)
+{
+    Box target_fine_region = fine_region & fine.box();
+    Box crse_bx(amrex::coarsen(target_fine_region,ratio));
+    Box fslope_bx(amrex::refine(crse_bx,ratio));
+    Box cslope_bx(crse_bx);
+    cslope_bx.grow(1);
+
+    int c_len = cslope_bx.numPts();
+    Vector<Real> cslope(5*c_len);
+    int loslp = cslope_bx.index(crse_bx.smallEnd());
+    int hislp = cslope_bx.index(crse_bx.bigEnd());
+    int clo = 1 - loslp;
+    int chi = clo + c_len - 1;
+    c_len = hislp - loslp + 1;
+
+    int dir;
+    int f_len = fslope_bx.longside(dir);
+    Vector<Real> strip((5+2)*f_len);
+    Real* fstrip = strip.dataPtr();
+    Real* foff   = fstrip + f_len;
+    Real* fslope = foff + f_len;
+
+    Vector<Real> fvc[AMREX_SPACEDIM];
+    Vector<Real> cvc[AMREX_SPACEDIM];
+    for (dir = 0; dir < AMREX_SPACEDIM; dir++)
+    {
+        fine_geom.GetEdgeVolCoord(fvc[dir],target_fine_region,dir);
+        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
+    }
+
+    int slope_flag = 1;
+    Vector<int> bc = Interpolater::GetBCArray(bcr);
+    const int* ratioV = ratio.getVect();
+    int actual = 0;
+
+    amrex_cqinterp(fine.dataPtr(),AMREX_ARLIM(fine.loVect()),AMREX_ARLIM(fine.hiVect()),
+                   AMREX_ARLIM(target_fine_region.loVect()), AMREX_ARLIM(target_fine_region.hiVect()),
+                   &ncomp,&ratioV[0],&ratioV[1],
+                   crse.dataPtr(),&clo,&chi,
+                   AMREX_ARLIM(crse_bx.loVect()), AMREX_ARLIM(crse_bx.hiVect()),
+                   fslope_bx.loVect(),fslope_bx.hiVect(),
+                   cslope.dataPtr(),&c_len,fslope,fstrip,&f_len,foff,
+                   bc.dataPtr(), &slope_flag,
+                   fvc[0].dataPtr(),fvc[1].dataPtr(),
+                   cvc[0].dataPtr(),cvc[1].dataPtr(),
+                   &actual,&actual);
+}
+#endif
+
+void fortran_protect (const FArrayBox& crse, FArrayBox& fine, FArrayBox& fine_state, int ncomp,
+                      const Box& fine_region, const IntVect& ratio, const Geometry& crse_geom,
+                      const Geometry& fine_geom, Vector<BCRec> const& bcr)
+{
+    Box target_fine_region = fine_region & fine.box();
+    Box crse_bx = amrex::grow(amrex::coarsen(target_fine_region,ratio),1);
+    Box cs_bx = amrex::grow(crse_bx,-1);
+
+    Vector<Real> fvc[AMREX_SPACEDIM];
+    Vector<Real> cvc[AMREX_SPACEDIM];
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
+    {
+        fine_geom.GetEdgeVolCoord(fvc[dir],target_fine_region,dir);
+        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
+    }
+
+#if (AMREX_SPACEDIM == 2)
+    const int* cvcblo = crse_bx.loVect();
+    const int* fvcblo = target_fine_region.loVect();
+    int cvcbhi[AMREX_SPACEDIM];
+    int fvcbhi[AMREX_SPACEDIM];
+    for (int dir=0; dir<AMREX_SPACEDIM; dir++)
+    {
+        cvcbhi[dir] = cvcblo[dir] + cvc[dir].size() - 1;
+        fvcbhi[dir] = fvcblo[dir] + fvc[dir].size() - 1;
+    }
+#endif
+
+    Vector<int> bc = Interpolater::GetBCArray(bcr);
+    const int* ratioV = ratio.getVect();
+
+    amrex_protect_interp(fine.dataPtr(),AMREX_ARLIM(fine.loVect()),AMREX_ARLIM(fine.hiVect()),
+                         target_fine_region.loVect(), target_fine_region.hiVect(),
+                         crse.dataPtr(),AMREX_ARLIM(crse.loVect()),AMREX_ARLIM(crse.hiVect()),
+                         cs_bx.loVect(), cs_bx.hiVect(),
+#if (AMREX_SPACEDIM == 2)
+                         fvc[0].dataPtr(),fvc[1].dataPtr(),
+                         AMREX_ARLIM(fvcblo), AMREX_ARLIM(fvcbhi),
+                         cvc[0].dataPtr(),cvc[1].dataPtr(),
+                         AMREX_ARLIM(cvcblo), AMREX_ARLIM(cvcbhi),
+#endif
+                         fine_state.dataPtr(), AMREX_ARLIM(fine_state.loVect()),
+                         AMREX_ARLIM(fine_state.hiVect()),
+                         &ncomp,AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
+                         bc.dataPtr());
+}
+
+void fortran_quartic (const FArrayBox& crse, FArrayBox& fine, int ncomp, const Box& fine_region,
+                      const IntVect& ratio, Vector<BCRec> const& bcr)
+{
+    Box target_fine_region = fine_region & fine.box();
+    Box crse_bx = amrex::grow(amrex::coarsen(target_fine_region,ratio),2);
+    Box crse_bx2 = amrex::grow(crse_bx,-2);
+    Box fine_bx2 = amrex::refine(crse_bx2,ratio);
+
+    const int* cblo = crse_bx.loVect();
+    const int* cbhi = crse_bx.hiVect();
+    const int* fb2lo = fine_bx2.loVect();
+    const int* fb2hi = fine_bx2.hiVect();
+
+    Vector<int> bc = Interpolater::GetBCArray(bcr);
+    const int* ratioV = ratio.getVect();
+    int actual = 0;
+
+    Vector<Real> ftmp(fb2hi[0]-fb2lo[0]+1);
+    Vector<Real> ctmp((cbhi[0]-cblo[0]+1)*ratio[1]);
+#if (AMREX_SPACEDIM == 3)
+    Vector<Real> ctmp2((cbhi[0]-cblo[0]+1)*(cbhi[1]-cblo[1]+1)*ratio[2]);
+#endif
+
+    amrex_quartinterp(fine.dataPtr(),AMREX_ARLIM(fine.loVect()),AMREX_ARLIM(fine.hiVect()),
+                      target_fine_region.loVect(), target_fine_region.hiVect(), fb2lo, fb2hi,
+                      crse.dataPtr(),AMREX_ARLIM(crse.loVect()),AMREX_ARLIM(crse.hiVect()),
+                      cblo, cbhi, crse_bx2.loVect(), crse_bx2.hiVect(),
+                      &ncomp,
+                      AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
+                      AMREX_D_DECL(ftmp.dataPtr(), ctmp.dataPtr(), ctmp2.dataPtr()),
+                      bc.dataPtr(),&actual,&actual);
+}
+
+template <class F>
+double time_it (int niters, F&& f)
+{
+    f();  // warm up
+    double t = amrex::second();
+    for (int i = 0; i < niters; ++i) f();
+    return (amrex::second() - t) / niters;
+}
+
+void report (const std::string& name, double tf, double tc, const FArrayBox& a, const FArrayBox& b)
+{
+    FArrayBox diff(a.box(), a.nComp());
+    diff.copy(a);
+    diff.minus(b);
+
+    amrex::Print() << std::left << std::setw(28) << name << "  C++: " << std::setw(12) << tc;
+    if (tf > 0.) {
+        amrex::Print() << "  Fortran: " << std::setw(12) << tf
+                       << "  speedup: " << std::setw(8) << tf/tc
+                       << "  max diff: " << diff.norm(0, 0, a.nComp()) << "\n";
+    } else {
+        amrex::Print() << "  (no Fortran version)\n";
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int ncomp = 4;
+        int niters = 10;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("ncomp", ncomp);
+            pp.query("niters", niters);
+        }
+
+        const IntVect ratio(2);
+        const Box fine_domain(IntVect(0), IntVect(n_cell-1));
+        const Box crse_domain = amrex::coarsen(fine_domain, ratio);
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        int is_per[] = {AMREX_D_DECL(0,0,0)};
+        Geometry fine_geom(fine_domain, &rb, 0, is_per);
+        Geometry crse_geom(crse_domain, &rb, 0, is_per);
+
+        // Physical boundaries on the low sides take the one-sided slopes.
+        Vector<BCRec> bcr(ncomp);
+        for (auto& bc : bcr) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                bc.setLo(idim, BCType::ext_dir);
+                bc.setHi(idim, BCType::int_dir);
+            }
+        }
+
+        // A smooth field plus noise, large enough for every interpolater.
+        FArrayBox crse(amrex::grow(crse_domain,2), ncomp);
+        {
+            auto const& a = crse.array();
+            const Box& bx = crse.box();
+            const auto lo = amrex::lbound(bx);
+            const auto hi = amrex::ubound(bx);
+            for (int n = 0; n < ncomp; ++n) {
+            for (int k = lo.z; k <= hi.z; ++k) {
+            for (int j = lo.y; j <= hi.y; ++j) {
+            for (int i = lo.x; i <= hi.x; ++i) {
+                a(i,j,k,n) = std::sin(0.1*(n+1)*i) + std::cos(0.2*j) * (1.0+0.1*k)
+                    + 0.01*amrex::Random();
+            }}}}
+        }
+
+        amrex::Print() << "InterpBenchmark: " << AMREX_SPACEDIM << "D, " << n_cell
+                       << " fine cells per side, " << ncomp << " components, "
+                       << "seconds per call averaged over " << niters << " calls\n";
+
+        FArrayBox fine_f(fine_domain, ncomp);
+        FArrayBox fine_c(fine_domain, ncomp);
+        fine_f.setVal(0.0);
+        fine_c.setVal(0.0);
+
+        // The Fortran quadratic interpolation takes the coarse data on exactly
+        // the coarse box of the fine region, as FillPatch passes it.
+        FArrayBox qcrse(quadratic_interp.CoarseBox(fine_domain, ratio), ncomp);
+        qcrse.copy(crse);
+
+        double tf = 0.;
+#if (AMREX_SPACEDIM == 2)
+        tf = time_it(niters, [&] () {
+            fortran_quadratic(qcrse, fine_f, ncomp, fine_domain, ratio, crse_geom, fine_geom, bcr);
+        });
+#endif
+        double tc = time_it(niters, [&] () {
+            quadratic_interp.interp(qcrse, 0, fine_c, 0, ncomp, fine_domain, ratio,
+                                    crse_geom, fine_geom, bcr, 0, 0, RunOn::Cpu);
+        });
+        report("CellQuadratic", tf, tc, fine_f, fine_c);
+
+        tf = time_it(niters, [&] () {
+            fortran_quartic(crse, fine_f, ncomp, fine_domain, ratio, bcr);
+        });
+        tc = time_it(niters, [&] () {
+            quartic_interp.interp(crse, 0, fine_c, 0, ncomp, fine_domain, ratio,
+                                  crse_geom, fine_geom, bcr, 0, 0, RunOn::Cpu);
+        });
+        report("CellConservativeQuartic", tf, tc, fine_f, fine_c);
+
+        // protect changes its input, so each call starts from a fresh
+        // correction whose sum with the state is negative here and there.
+        FArrayBox state(fine_domain, ncomp);
+        FArrayBox corr(fine_domain, ncomp);
+        {
+            auto const& s = state.array();
+            auto const& c = corr.array();
+            const auto lo = amrex::lbound(fine_domain);
+            const auto hi = amrex::ubound(fine_domain);
+            for (int n = 0; n < ncomp; ++n) {
+            for (int k = lo.z; k <= hi.z; ++k) {
+            for (int j = lo.y; j <= hi.y; ++j) {
+            for (int i = lo.x; i <= hi.x; ++i) {
+                s(i,j,k,n) = amrex::Random() - 0.1;
+                c(i,j,k,n) = amrex::Random() - 0.5;
+            }}}}
+        }
+        tf = time_it(niters, [&] () {
+            fine_f.copy(corr);
+            fortran_protect(crse, fine_f, state, ncomp, fine_domain, ratio, crse_geom, fine_geom, bcr);
+        });
+        tc = time_it(niters, [&] () {
+            fine_c.copy(corr);
+            protected_interp.protect(crse, 0, fine_c, 0, state, 0, ncomp, fine_domain, ratio,
+                                     crse_geom, fine_geom, bcr, RunOn::Cpu);
+        });
+        report("CellConservativeProtected", tf, tc, fine_f, fine_c);
+    }
+    amrex::Finalize();
+}
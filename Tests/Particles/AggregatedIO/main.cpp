@@ -0,0 +1,138 @@
+//
+// Writes a checkpoint in the aggregated particle format, restarts from it
+// on different grids and reads part of it back, and checks the particles.
+// Run it with more than one rank, e.g.,
+//
+//     mpiexec -n 4 ./main3d.gnu.MPI.ex inputs
+//
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Particles.H>
+
+using namespace amrex;
+
+using MyPC = ParticleContainer<2, 1, 1, 1>;
+
+namespace {
+
+// The components are functions of the id and the position, so every
+// particle can be checked on its own.
+Real realComp (int id, int comp) { return 0.5*id + comp; }
+int  intComp  (int id, int comp) { return (id % 7) - comp; }
+Real posSum   (const MyPC::ParticleType& p) { return AMREX_D_TERM(p.pos(0), + p.pos(1), + p.pos(2)); }
+
+void setComponents (MyPC& pc)
+{
+    for (MyPC::ParIterType pti(pc, 0); pti.isValid(); ++pti) {
+        auto& aos = pti.GetArrayOfStructs();
+        auto& sr = pti.GetStructOfArrays().GetRealData(0);
+        auto& si = pti.GetStructOfArrays().GetIntData(0);
+        for (int i = 0; i < aos.numParticles(); ++i) {
+            auto& p = aos[i];
+            p.rdata(0) = realComp(p.id(), 0);
+            p.rdata(1) = realComp(p.id(), 1);
+            p.idata(0) = intComp(p.id(), 0);
+            sr[i] = posSum(p);
+            si[i] = intComp(p.id(), 1);
+        }
+    }
+}
+
+// Returns the number of particles inside region, and their sum of ids.
+// Aborts if the components of a particle are wrong.
+std::pair<long,long> checkParticles (const MyPC& pc, const RealBox& region,
+                                     bool check_real, bool check_int)
+{
+    long n = 0, idsum = 0;
+    for (MyPC::ParConstIterType pti(pc, 0); pti.isValid(); ++pti) {
+        const auto& aos = pti.GetArrayOfStructs();
+        const auto& sr = pti.GetStructOfArrays().GetRealData(0);
+        const auto& si = pti.GetStructOfArrays().GetIntData(0);
+        for (int i = 0; i < aos.numParticles(); ++i) {
+            const auto& p = aos[i];
+            if (p.id() <= 0) continue;
+            bool ok = true;
+            if (check_real) {
+                ok = ok && p.rdata(0) == realComp(p.id(), 0) && p.rdata(1) == realComp(p.id(), 1)
+                    && sr[i] == posSum(p);
+            }
+            if (check_int) {
+                ok = ok && p.idata(0) == intComp(p.id(), 0) && si[i] == intComp(p.id(), 1);
+            }
+            if (!ok) amrex::Abort("AggregatedIO: wrong data for particle " + std::to_string(p.id()));
+            const Real pos[] = {AMREX_D_DECL(p.pos(0), p.pos(1), p.pos(2))};
+            if (region.contains(pos)) {
+                ++n;
+                idsum += p.id();
+            }
+        }
+    }
+    ParallelDescriptor::ReduceLongSum(n);
+    ParallelDescriptor::ReduceLongSum(idsum);
+    return std::make_pair(n, idsum);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int ncell = 32;
+        int max_grid_size = 16;
+        int nparticles = 20000;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nparticles", nparticles);
+        }
+        {
+            ParmParse pp("particles");
+            int aggregated = 1;
+            pp.query("aggregated_io", aggregated);
+            if (!aggregated) amrex::Abort("AggregatedIO: particles.aggregated_io must be 1");
+        }
+
+        RealBox real_box({AMREX_D_DECL(0.0,0.0,0.0)}, {AMREX_D_DECL(1.0,1.0,1.0)});
+        const Box domain(IntVect(AMREX_D_DECL(0,0,0)), IntVect(AMREX_D_DECL(ncell-1,ncell-1,ncell-1)));
+        Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(1,1,1)};
+        Geometry geom(domain, real_box, CoordSys::cartesian, is_per);
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MyPC pc(geom, dm, ba);
+        MyPC::ParticleInitData pdata = {{0.0, 0.0}, {0}, {0.0}, {0}};
+        pc.InitRandom(nparticles, 451, pdata, false);
+        setComponents(pc);
+
+        const auto all = checkParticles(pc, real_box, true, true);
+        pc.Checkpoint("agg_chk", "particles");
+
+        // Restart on other grids
+        BoxArray ba2(domain);
+        ba2.maxSize(max_grid_size/2);
+        DistributionMapping dm2(ba2);
+        MyPC pc2(geom, dm2, ba2);
+        pc2.Restart("agg_chk", "particles");
+        const auto restarted = checkParticles(pc2, real_box, true, true);
+        if (restarted != all) amrex::Abort("AggregatedIO: restart lost particles");
+
+        // Read the integer components of the particles in a corner only
+        const RealBox corner({AMREX_D_DECL(0.1,0.2,0.3)}, {AMREX_D_DECL(0.6,0.7,0.8)});
+        MyPC pc3(geom, dm, ba);
+        Vector<int> read_real(2 + 1, 0);
+        Vector<int> read_int(1 + 1, 1);
+        pc3.ReadAggregatedParticleData("agg_chk", "particles", corner, read_real, read_int);
+        const auto in_corner = checkParticles(pc, corner, false, false);
+        const auto read = checkParticles(pc3, real_box, false, true);
+        if (read != in_corner) amrex::Abort("AggregatedIO: wrong particles read from region");
+
+        amrex::Print() << "AggregatedIO passed: " << all.first << " particles, "
+                       << in_corner.first << " in the region\n";
+    }
+    amrex::Finalize();
+}
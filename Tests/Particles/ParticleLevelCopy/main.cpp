@@ -0,0 +1,101 @@
+//
+// Copies and assigns the particles of a level, with tiles both in the
+// tile layout and outside of it, and checks that the copies are equal.
+//
+
+#include <AMReX.H>
+#include <AMReX_Particles.H>
+
+using namespace amrex;
+
+using MyPC = ParticleContainer<1, 0, 1, 0>;
+using ParticleLevel = MyPC::ParticleLevel;
+
+namespace {
+
+long checkSum (const ParticleLevel& plev)
+{
+    long sum = 0;
+    for (const auto& kv : plev) {
+        const auto& aos = kv.second.GetArrayOfStructs();
+        for (int i = 0; i < aos.numParticles(); ++i) {
+            sum += aos[i].id() * (kv.first.first + 1) * (kv.first.second + 2);
+        }
+        sum += kv.second.numParticles();
+    }
+    return sum;
+}
+
+void check (bool ok, const char* what)
+{
+    if (!ok) amrex::Abort(std::string("ParticleLevelCopy failed: ") + what);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        const int ncell = 32;
+        RealBox real_box({AMREX_D_DECL(0.0,0.0,0.0)}, {AMREX_D_DECL(1.0,1.0,1.0)});
+        const Box domain(IntVect(AMREX_D_DECL(0,0,0)), IntVect(AMREX_D_DECL(ncell-1,ncell-1,ncell-1)));
+        Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(1,1,1)};
+        Geometry geom(domain, real_box, CoordSys::cartesian, is_per);
+
+        BoxArray ba(domain);
+        ba.maxSize(16);
+        DistributionMapping dm(ba);
+
+        MyPC pc(geom, dm, ba);
+        pc.do_tiling = true;
+        pc.tile_size = IntVect(AMREX_D_DECL(8,8,8));
+
+        MyPC::ParticleInitData pdata = {{1.0}, {}, {2.0}, {}};
+        pc.InitRandom(10000, 451, pdata, false);
+
+        ParticleLevel& plev = pc.GetParticles(0);
+
+        // A tile that is not part of the layout
+        auto& extra = plev[std::make_pair(ba.size()+3, 0)];
+        MyPC::ParticleType p;
+        p.id() = 7;
+        p.cpu() = ParallelDescriptor::MyProc();
+        AMREX_D_TERM(p.pos(0) = 0.5;, p.pos(1) = 0.5;, p.pos(2) = 0.5;)
+        p.rdata(0) = 1.0;
+        extra.push_back(p);
+
+        const long sum0 = checkSum(plev);
+        const auto n0 = plev.size();
+
+        ParticleLevel copied(plev);
+        check(copied.size() == n0 && checkSum(copied) == sum0, "copy construction");
+
+        ParticleLevel assigned;
+        assigned[std::make_pair(0,0)];
+        assigned = plev;
+        check(assigned.size() == n0 && checkSum(assigned) == sum0, "copy assignment");
+
+        // Assign onto a level with the same layout and different contents
+        MyPC pc2(geom, dm, ba);
+        pc2.do_tiling = true;
+        pc2.tile_size = pc.tile_size;
+        pc2.InitRandom(500, 17, pdata, false);
+        pc2.GetParticles(0) = plev;
+        check(pc2.GetParticles(0).size() == n0 && checkSum(pc2.GetParticles(0)) == sum0,
+              "assignment onto a defined level");
+        check(pc2.GetParticles(0).find(std::make_pair(ba.size()+3,0)) != pc2.GetParticles(0).end(),
+              "tile outside of the layout");
+
+        // The copies do not share storage with the original
+        plev.clear();
+        check(plev.empty() && checkSum(copied) == sum0 && checkSum(assigned) == sum0,
+              "independent storage");
+
+        copied = copied;
+        check(checkSum(copied) == sum0, "self assignment");
+
+        amrex::Print() << "ParticleLevelCopy passed\n";
+    }
+    amrex::Finalize();
+}
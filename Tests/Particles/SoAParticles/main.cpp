@@ -0,0 +1,224 @@
+//
+// Redistributes the particles of a SoAParticleContainer, writes them to a
+// checkpoint and restarts from it, on the same grids, on other grids and
+// into a ParticleContainer with the same components, and checks that no
+// particle is lost or changed on the way.  It also interpolates a linear
+// field to the particles with a callback that takes the particle by
+// reference.
+//
+
+#include <AMReX.H>
+#include <AMReX_SoAParticles.H>
+#include <AMReX_ParticleMesh.H>
+
+using namespace amrex;
+
+using SoAPC = SoAParticleContainer<2, 1>;
+using AoSPC = ParticleContainer<0, 0, 2, 1>;
+
+namespace {
+
+void check (bool ok, const std::string& what)
+{
+    if (!ok) amrex::Abort("SoAParticles failed: " + what);
+}
+
+// The sums over the particles of their id times each component, so that a
+// particle whose components are swapped with those of another is noticed.
+struct CheckSums
+{
+    long np = 0;
+    long idsum = 0;
+    Real rsum[AMREX_SPACEDIM+2] = {};
+    long isum = 0;
+    long misplaced = 0;
+
+    void reduce ()
+    {
+        ParallelDescriptor::ReduceLongSum(np);
+        ParallelDescriptor::ReduceLongSum(idsum);
+        ParallelDescriptor::ReduceRealSum(rsum, AMREX_SPACEDIM+2);
+        ParallelDescriptor::ReduceLongSum(isum);
+        ParallelDescriptor::ReduceLongSum(misplaced);
+    }
+
+    template <class P>
+    void add (const P& p, const Box& bx, const Geometry& geom)
+    {
+        ++np;
+        idsum += p.id();
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) rsum[d] += p.id()*p.pos(d);
+        for (int n = 0; n < 2; ++n) rsum[AMREX_SPACEDIM+n] += p.id()*p.rdata(n);
+        isum += long(p.id())*p.idata(0);
+        const IntVect iv(AMREX_D_DECL(int(std::floor((p.pos(0)-geom.ProbLo(0))*geom.InvCellSize(0))),
+                                      int(std::floor((p.pos(1)-geom.ProbLo(1))*geom.InvCellSize(1))),
+                                      int(std::floor((p.pos(2)-geom.ProbLo(2))*geom.InvCellSize(2)))));
+        if (!bx.contains(iv)) ++misplaced;
+    }
+
+    void compare (const CheckSums& rhs, const std::string& what) const
+    {
+        check(np == rhs.np, what + ": number of particles");
+        check(idsum == rhs.idsum, what + ": ids");
+        for (int n = 0; n < AMREX_SPACEDIM+2; ++n) {
+            check(std::abs(rsum[n]-rhs.rsum[n]) <= 1.e-10*std::abs(rsum[n]), what + ": real components");
+        }
+        check(isum == rhs.isum, what + ": int components");
+    }
+};
+
+CheckSums checkSums (const SoAPC& pc)
+{
+    CheckSums cs;
+    for (SoAParConstIter<2,1> pti(pc, 0); pti.isValid(); ++pti) {
+        const auto ptd = pti.getParticleTileData();
+        for (int i = 0; i < pti.numParticles(); ++i) {
+            cs.add(ptd[i], pti.validbox(), pc.Geom(0));
+        }
+    }
+    cs.reduce();
+    return cs;
+}
+
+CheckSums checkSums (const AoSPC& pc)
+{
+    CheckSums cs;
+    for (AoSPC::ParConstIterType pti(pc, 0); pti.isValid(); ++pti) {
+        const auto& aos = pti.GetArrayOfStructs();
+        const auto& soa = pti.GetStructOfArrays();
+        for (int i = 0; i < pti.numParticles(); ++i) {
+            Particle<2,1> p;
+            p.id() = aos[i].id();
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) p.pos(d) = aos[i].pos(d);
+            for (int n = 0; n < 2; ++n) p.rdata(n) = soa.GetRealData(n)[i];
+            p.idata(0) = soa.GetIntData(0)[i];
+            cs.add(p, pti.validbox(), pc.Geom(0));
+        }
+    }
+    cs.reduce();
+    return cs;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        const int ncell = 32;
+        RealBox real_box({AMREX_D_DECL(0.0,0.0,0.0)}, {AMREX_D_DECL(1.0,1.0,1.0)});
+        const Box domain(IntVect(AMREX_D_DECL(0,0,0)), IntVect(AMREX_D_DECL(ncell-1,ncell-1,ncell-1)));
+        Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(1,1,1)};
+        Geometry geom(domain, real_box, CoordSys::cartesian, is_per);
+
+        BoxArray ba(domain);
+        ba.maxSize(8);
+        DistributionMapping dm(ba);
+
+        // Each rank puts its particles on one grid, some of them outside
+        // of the domain, so that Redistribute moves almost all of them
+        // across the periodic boundaries and the ranks.
+        SoAPC pc(geom, dm, ba);
+        const int np_per_rank = 2000;
+        {
+            auto& ptile = pc.DefineAndReturnParticleTile(0, 0, 0);
+            for (int i = 0; i < np_per_rank; ++i) {
+                Particle<2,1> p;
+                p.id() = Particle<0,0>::NextID();
+                p.cpu() = ParallelDescriptor::MyProc();
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    p.pos(d) = -0.2 + 1.4*amrex::Random();
+                }
+                p.rdata(0) = amrex::Random();
+                p.rdata(1) = p.id() + 0.5;
+                p.idata(0) = 3*p.id();
+                ptile.push_back(p);
+            }
+        }
+
+        // The positions once moved into the domain
+        CheckSums expected;
+        for (const auto& kv : pc.GetParticles(0)) {
+            const auto ptd = kv.second.getConstParticleTileData();
+            for (int i = 0; i < kv.second.numParticles(); ++i) {
+                Particle<2,1> p = ptd.getSuperParticle(i);
+                enforcePeriodic(p, geom.ProbLoArray(), geom.ProbHiArray(), geom.isPeriodicArray());
+                expected.add(p, domain, geom);
+            }
+        }
+        expected.reduce();
+        check(expected.np == long(np_per_rank)*ParallelDescriptor::NProcs(), "setup");
+
+        pc.Redistribute();
+        CheckSums after = checkSums(pc);
+        after.compare(expected, "Redistribute");
+        check(after.misplaced == 0, "Redistribute: particles outside of their grid");
+
+        // Move the particles and redistribute again, this time only to
+        // the neighboring grids.
+        for (SoAParIter<2,1> pti(pc, 0); pti.isValid(); ++pti) {
+            auto& x = pti.GetParticleTile().pos(0);
+            for (auto& v : x) v += 0.5/ncell;
+        }
+        pc.Redistribute(0, -1, 0, 1);
+        const CheckSums moved = checkSums(pc);
+        check(moved.np == expected.np, "local Redistribute: number of particles");
+        check(moved.misplaced == 0, "local Redistribute: particles outside of their grid");
+
+        // Checkpoint and restart on the same grids
+        pc.Checkpoint("soa_chk", "particles", {"weight", "tag"}, {"flag"});
+        SoAPC pc_same(geom, dm, ba);
+        pc_same.Restart("soa_chk", "particles");
+        CheckSums restarted = checkSums(pc_same);
+        restarted.compare(moved, "Restart");
+        check(restarted.misplaced == 0, "Restart: particles outside of their grid");
+
+        // On other grids
+        BoxArray ba2(domain);
+        ba2.maxSize(16);
+        DistributionMapping dm2(ba2);
+        SoAPC pc_other(geom, dm2, ba2);
+        pc_other.Restart("soa_chk", "particles");
+        restarted = checkSums(pc_other);
+        restarted.compare(moved, "Restart on other grids");
+        check(restarted.misplaced == 0, "Restart on other grids: particles outside of their grid");
+
+        // Into a ParticleContainer, and back from its checkpoint
+        AoSPC apc(geom, dm, ba);
+        apc.Restart("soa_chk", "particles");
+        restarted = checkSums(apc);
+        restarted.compare(moved, "ParticleContainer::Restart");
+
+        apc.Checkpoint("soa_chk", "aos_particles");
+        SoAPC pc_from_aos(geom, dm2, ba2);
+        pc_from_aos.Restart("soa_chk", "aos_particles");
+        restarted = checkSums(pc_from_aos);
+        restarted.compare(moved, "Restart from a ParticleContainer");
+
+        // Interpolate x + 2y; the callback writes through the proxy.
+        MultiFab field(ba, dm, 1, ParticleShape<1>::nghost);
+        const auto dx = geom.CellSizeArray();
+        for (MFIter mfi(field); mfi.isValid(); ++mfi) {
+            const auto a = field.array(mfi);
+            amrex::LoopOnCpu(mfi.fabbox(), [=] (int i, int j, int k) {
+                amrex::ignore_unused(k);
+                a(i,j,k) = (i+0.5)*dx[0] + 2.0*(j+0.5)*dx[1];
+            });
+        }
+        MeshToParticle<1,1>(pc, field, 0, 0,
+            [=] (SoAParticle<2,1>& p, GpuArray<Real,1> const& v) { p.rdata(0) = v[0]; });
+        Real err = 0.0;
+        for (SoAParConstIter<2,1> pti(pc, 0); pti.isValid(); ++pti) {
+            const auto ptd = pti.getParticleTileData();
+            for (int i = 0; i < pti.numParticles(); ++i) {
+                const auto p = ptd[i];
+                err = std::max(err, std::abs(p.rdata(0) - (p.pos(0) + 2.0*p.pos(1))));
+            }
+        }
+        ParallelDescriptor::ReduceRealMax(err);
+        check(err < 1.e-12, "MeshToParticle");
+
+        amrex::Print() << "SoAParticles passed with " << moved.np << " particles\n";
+    }
+    amrex::Finalize();
+}
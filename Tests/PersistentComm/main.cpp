@@ -0,0 +1,148 @@
+//
+// Runs the same sequence of FillBoundary, overlapping FillBoundary_nowait
+// and multi-pass ParallelCopy calls with fabarray.use_persistent_comm off
+// and on, and checks that the results are the same and that all ranks
+// have drawn the same number of sequence numbers.  The grids leave some
+// ranks without any work, so run it on 4 or more ranks.  A mismatch of
+// the message tags shows up as a hang or as wrong data.
+//
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+
+using namespace amrex;
+
+namespace {
+
+void check (bool ok, const std::string& what)
+{
+    if (!ok) amrex::Abort("PersistentComm failed: " + what);
+}
+
+// Boxes assigned round-robin to the ranks [first, first+n)
+DistributionMapping makeDM (const BoxArray& ba, int first, int n)
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+    Vector<int> pmap(ba.size());
+    for (int i = 0; i < ba.size(); ++i) {
+        pmap[i] = std::min(first + i % n, nprocs-1);
+    }
+    return DistributionMapping(pmap);
+}
+
+void fillValid (MultiFab& mf, Real offset)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const auto a = mf.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), mf.nComp(), [=] (int i, int j, int k, int n) {
+            a(i,j,k,n) = offset + i + 100.*j + 10000.*k + 0.25*n;
+        });
+    }
+}
+
+void setGhost (MultiFab& mf)
+{
+    mf.setBndry(-1.0);
+}
+
+// The results of one run of the sequence, one MultiFab per step
+Vector<std::unique_ptr<MultiFab> > runSequence (bool persistent, const Geometry& geom,
+                                                const BoxArray& ba, const DistributionMapping& dm,
+                                                const BoxArray& ba2, const DistributionMapping& dm2)
+{
+    FabArrayBase::use_persistent_comm = persistent;
+
+    const int ncomp = 5;
+    MultiFab mf1(ba, dm, ncomp, 2), mf2(ba, dm, ncomp, 2), mf3(ba, dm, ncomp, 1);
+    MultiFab dst(ba2, dm2, ncomp, 1);
+    fillValid(mf1, 0.0);
+    fillValid(mf2, 0.5);
+    fillValid(mf3, 0.75);
+
+    const Periodicity& period = geom.periodicity();
+    Vector<std::unique_ptr<MultiFab> > r;
+    auto save = [&r] (const MultiFab& mf) {
+        r.emplace_back(new MultiFab(mf.boxArray(), mf.DistributionMap(), mf.nComp(), mf.nGrow()));
+        MultiFab::Copy(*r.back(), mf, 0, 0, mf.nComp(), mf.nGrow());
+    };
+
+    for (int rep = 0; rep < 3; ++rep)
+    {
+        setGhost(mf1);
+        setGhost(mf2);
+        setGhost(mf3);
+
+        // mf1 and mf2 share their FB, so the second exchange cannot use
+        // the plan of the first.
+        mf1.FillBoundary_nowait(period);
+        mf2.FillBoundary_nowait(1, 3, period);
+        mf3.FillBoundary(period);
+        mf2.FillBoundary_finish();
+        mf1.FillBoundary_finish();
+        save(mf1);
+        save(mf2);
+        save(mf3);
+
+        // MaxComp is 2, so this takes three passes.
+        dst.setVal(0.0);
+        dst.ParallelCopy(mf1, 0, 0, ncomp, 0, 1, period);
+        save(dst);
+        dst.ParallelCopy(mf2, 1, 0, 3, 1, 0, period, FabArrayBase::ADD);
+        save(dst);
+    }
+
+    int seq = ParallelDescriptor::SeqNum();
+    int seq_min = seq, seq_max = seq;
+    ParallelDescriptor::ReduceIntMin(seq_min);
+    ParallelDescriptor::ReduceIntMax(seq_max);
+    check(seq_min == seq_max, std::string("sequence numbers differ across ranks with persistence ")
+          + (persistent ? "on" : "off"));
+
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        const int nprocs = ParallelDescriptor::NProcs();
+
+        const Box domain(IntVect(AMREX_D_DECL(0,0,0)), IntVect(AMREX_D_DECL(31,31,31)));
+        RealBox real_box({AMREX_D_DECL(0.0,0.0,0.0)}, {AMREX_D_DECL(1.0,1.0,1.0)});
+        Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(1,1,1)};
+        Geometry geom(domain, real_box, CoordSys::cartesian, is_per);
+
+        // The first half of the ranks own the source grids and the ranks
+        // from 1 to nprocs/2 the destination grids, so with 4 ranks the
+        // last one has nothing to do and the third one only copies.
+        BoxArray ba(domain);
+        ba.maxSize(8);
+        const DistributionMapping dm = makeDM(ba, 0, std::max(nprocs/2, 1));
+        BoxArray ba2(domain);
+        ba2.maxSize(16);
+        const DistributionMapping dm2 = makeDM(ba2, std::min(1, nprocs-1), std::max(nprocs/2, 1));
+
+        FabArrayBase::MaxComp = 2;
+
+        const auto ref = runSequence(false, geom, ba, dm, ba2, dm2);
+        auto res = runSequence(true, geom, ba, dm, ba2, dm2);
+        // Once more, now that the plans exist
+        auto res2 = runSequence(true, geom, ba, dm, ba2, dm2);
+
+        for (int i = 0; i < ref.size(); ++i) {
+            for (MultiFab* r : {res[i].get(), res2[i].get()}) {
+                MultiFab::Subtract(*r, *ref[i], 0, 0, r->nComp(), r->nGrow());
+                for (int n = 0; n < r->nComp(); ++n) {
+                    check(r->norm0(n, r->nGrow()) == 0.0,
+                          "step " + std::to_string(i) + " differs with persistence on");
+                }
+            }
+        }
+
+        amrex::Print() << "PersistentComm passed on " << nprocs << " ranks\n";
+    }
+    amrex::Finalize();
+}
@@ -162,6 +162,9 @@ void main_main()
     Vector<Real> pos;
     Vector<Vector<Real> > data(var_names.size());
 
+    // Only the grids that intersect the slice are read, and only the
+    // requested variables of those grids.
+    const int myproc = ParallelDescriptor::MyProc();
     IntVect rr{1};
     for (int ilev = coarse_level; ilev <= fine_level; ++ilev) {
         Box slice_box(ivloc*rr,ivloc*rr);
@@ -170,69 +173,59 @@ void main_main()
 
         Array<Real,AMREX_SPACEDIM> dx = pf.cellSize(ilev);
 
+        IntVect ratio{1};
+        BoxArray covered;  // fine grids coarsened to this level
         if (ilev < fine_level) {
-            IntVect ratio{pf.refRatio(ilev)};
+            ratio = IntVect{pf.refRatio(ilev)};
             for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
                 ratio[idim] = 1;
             }
-            const iMultiFab mask = makeFineMask(pf.boxArray(ilev), pf.DistributionMap(ilev),
-                                                pf.boxArray(ilev+1), ratio);
-            for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                const MultiFab& mf = pf.get(ilev, var_names[ivar]);
-                for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-                    const Box& bx = mfi.validbox() & slice_box;
-                    if (bx.ok()) {
-                        const auto& m = mask.array(mfi);
-                        const auto& fab = mf.array(mfi);
-                        const auto lo = amrex::lbound(bx);
-                        const auto hi = amrex::ubound(bx);
-                        for         (int k = lo.z; k <= hi.z; ++k) {
-                            for     (int j = lo.y; j <= hi.y; ++j) {
-                                for (int i = lo.x; i <= hi.x; ++i) {
-                                    if (m(i,j,k) == 0) { // not covered by fine
-                                        if (pos.size() == data[ivar].size()) {
-                                            Array<Real,AMREX_SPACEDIM> p
-                                                = {AMREX_D_DECL(problo[0]+(i+0.5)*dx[0],
-                                                                problo[1]+(j+0.5)*dx[1],
-                                                                problo[2]+(k+0.5)*dx[2])};
-                                            pos.push_back(p[idir]);
-                                        }
-                                        data[ivar].push_back(fab(i,j,k));
-                                    }
-                                }
-                            }
-                        }
-                    }
+            covered = amrex::coarsen(pf.boxArray(ilev+1), ratio);
+        }
+
+        const DistributionMapping& dm = pf.DistributionMap(ilev);
+        for (auto const& isect : pf.boxArray(ilev).intersections(slice_box)) {
+            const int gid = isect.first;
+            if (dm[gid] != myproc) continue;
+
+            const Box& bx = isect.second;
+            IArrayBox mask(bx);
+            mask.setVal(0);
+            if (ilev < fine_level) {
+                for (auto const& fisect : covered.intersections(bx)) {
+                    mask.setVal(1, fisect.second, 0, 1);
                 }
             }
-            rr *= ratio;
-        } else {
+            const auto& m = mask.array();
+
+            Vector<FArrayBox> fabs;
+            Vector<Array4<Real const> > fab;
+            fabs.reserve(var_names.size());
             for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                const MultiFab& mf = pf.get(ilev, var_names[ivar]);
-                for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-                    const Box& bx = mfi.validbox() & slice_box;
-                    if (bx.ok()) {
-                        const auto& fab = mf.array(mfi);
-                        const auto lo = amrex::lbound(bx);
-                        const auto hi = amrex::ubound(bx);
-                        for         (int k = lo.z; k <= hi.z; ++k) {
-                            for     (int j = lo.y; j <= hi.y; ++j) {
-                                for (int i = lo.x; i <= hi.x; ++i) {
-                                    if (pos.size() == data[ivar].size()) {
-                                        Array<Real,AMREX_SPACEDIM> p
-                                            = {AMREX_D_DECL(problo[0]+(i+0.5)*dx[0],
-                                                            problo[1]+(j+0.5)*dx[1],
-                                                            problo[2]+(k+0.5)*dx[2])};
-                                        pos.push_back(p[idir]);
-                                    }
-                                    data[ivar].push_back(fab(i,j,k));
-                                }
+                fabs.push_back(pf.getFab(ilev, gid, var_names[ivar]));
+                fab.push_back(fabs.back().const_array());
+            }
+
+            const auto lo = amrex::lbound(bx);
+            const auto hi = amrex::ubound(bx);
+            for         (int k = lo.z; k <= hi.z; ++k) {
+                for     (int j = lo.y; j <= hi.y; ++j) {
+                    for (int i = lo.x; i <= hi.x; ++i) {
+                        if (m(i,j,k) == 0) { // not covered by fine
+                            Array<Real,AMREX_SPACEDIM> p
+                                = {AMREX_D_DECL(problo[0]+(i+0.5)*dx[0],
+                                                problo[1]+(j+0.5)*dx[1],
+                                                problo[2]+(k+0.5)*dx[2])};
+                            pos.push_back(p[idir]);
+                            for (int ivar = 0; ivar < var_names.size(); ++ivar) {
+                                data[ivar].push_back(fab[ivar](i,j,k));
                             }
                         }
                     }
                 }
             }
         }
+        rr *= ratio;
     }
 
 #ifdef BL_USE_MPI
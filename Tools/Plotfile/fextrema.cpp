@@ -64,28 +64,36 @@ void main_main()
 
         const int dim = pf.spaceDim();
 
+        const int myproc = ParallelDescriptor::MyProc();
         for (int ilev = pf.finestLevel(); ilev >= 0; --ilev) {
             if (ilev == pf.finestLevel()) {
+                // These come from the MultiFab header if it has them.
                 for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                    const MultiFab& mf = pf.get(ilev, var_names[ivar]);
-                    vvmin[ivar] = mf.min(0,0,false);
-                    vvmax[ivar] = mf.max(0,0,false);
+                    vvmin[ivar] = pf.min(ilev, var_names[ivar]);
+                    vvmax[ivar] = pf.max(ilev, var_names[ivar]);
                 }
             } else {
                 IntVect ratio{pf.refRatio(ilev)};
                 for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
                     ratio[idim] = 1;
                 }
-                iMultiFab mask = makeFineMask(pf.boxArray(ilev), pf.DistributionMap(ilev),
-                                              pf.boxArray(ilev+1), ratio);
-                for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                    const MultiFab& mf = pf.get(ilev, var_names[ivar]);
-                    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-                        const Box& bx = mfi.validbox();
-                        const auto lo = amrex::lbound(bx);
-                        const auto hi = amrex::ubound(bx);
-                        const auto& ifab = mask.array(mfi);
-                        const auto& fab = mf.array(mfi);
+                const BoxArray& ba = pf.boxArray(ilev);
+                const DistributionMapping& dm = pf.DistributionMap(ilev);
+                const BoxArray covered = amrex::coarsen(pf.boxArray(ilev+1), ratio);
+                for (int gid = 0; gid < ba.size(); ++gid) {
+                    if (dm[gid] != myproc) continue;
+                    const Box& bx = ba[gid];
+                    IArrayBox mask(bx);
+                    mask.setVal(0);
+                    for (auto const& fisect : covered.intersections(bx)) {
+                        mask.setVal(1, fisect.second, 0, 1);
+                    }
+                    const auto& ifab = mask.const_array();
+                    const auto lo = amrex::lbound(bx);
+                    const auto hi = amrex::ubound(bx);
+                    for (int ivar = 0; ivar < var_names.size(); ++ivar) {
+                        const FArrayBox& data = pf.getFab(ilev, gid, var_names[ivar]);
+                        const auto& fab = data.const_array();
                         for         (int k = lo.z; k <= hi.z; ++k) {
                             for     (int j = lo.y; j <= hi.y; ++j) {
                                 for (int i = lo.x; i <= hi.x; ++i) {